@@ -27,15 +27,30 @@ void spawn_entity()
     entity_add<Transform>(entity).position = position;
     entity_add<Sprite>(entity).tint = GetRandomColor();
     sprite_set_sub_texture(entity_get<Sprite>(entity), "cpp");
-    reset_movement(entity_get<Transform>(entity), entity_add<Move>(entity));
+    auto& move = entity_add<Move>(entity);
+    reset_movement(entity_get<Transform>(entity), move);
 }
 
 // -----------------------------------------------------------------
 
 void init();
 
+// "app 100000" spawns that many moving quads and logs the average frame time, to measure the renderer under load
+u32 benchmark_quads = 0;
+constexpr u32 BENCHMARK_FRAMES = 300;
+
 int main(int argc, char** argv)
 {
+    if (argc > 1)
+    {
+        benchmark_quads = (u32) std::strtoul(argv[1], nullptr, 10);
+
+        // Creates the engine, the entity limit has to be raised before engine_init loads the registry
+        engine_event(Stage::Init);
+        u32& max_entities = engine_get_instance()->entity_registry.max_entities;
+        max_entities = std::max(max_entities, benchmark_quads + 1024);
+    }
+    
     engine_init(init);
 }
 
@@ -51,7 +66,10 @@ void init()
     engine_event(Stage::Update) += EngineListener::create(game_update);
 
     component_register<Move>();
-    entity_create_group<Transform, Sprite, Move>();
+    entity_create_group<Transform, Move>();
+    
+    // Sprite is left out so it runs at the same time as the flipbook animations of the draw system, which write it
+    engine_system_access(EngineListener::create(game_update), {}, entity_build_signature<Transform, Move>());
 }
 
 AssetHandle test_scene;
@@ -64,19 +82,49 @@ ListenerAction game_start()
     {
         asset_load(test_scene);
     }
+
+    if (benchmark_quads != 0)
+    {
+        // Otherwise the frame time is the refresh rate
+        window_set_v_sync(false);
+    }
+
+    for (u32 i = 0; i < benchmark_quads; ++i)
+    {
+        spawn_entity();
+    }
     
     return ListenerAction::StayListening;
 }
 
+static void benchmark_update()
+{
+    static f64 start_seconds = 0.0;
+    static u32 start_frame   = 0;
+    const Engine* engine     = engine_get_instance();
+
+    if (engine->frame_count - start_frame < BENCHMARK_FRAMES)
+    {
+        return;
+    }
+
+    const f64 ms_per_frame = (engine->seconds - start_seconds) * 1000.0 / (f64) (engine->frame_count - start_frame);
+    NIT_LOG_TRACE("%u quads: %.3f ms per frame", benchmark_quads, ms_per_frame);
+    start_seconds = engine->seconds;
+    start_frame   = engine->frame_count;
+}
+
 ListenerAction game_update()
 {
     //spawn_entity();
+
+    if (benchmark_quads != 0)
+    {
+        benchmark_update();
+    }
     
-    for (EntityID entity : entity_get_group<Transform, Sprite, Move>().entities)
+    parallel_for(entity_view<Transform, Move>(), 256, [](EntityID, Transform& transform, Move& move)
     {
-        auto& transform = entity_get<Transform>(entity);
-        auto& move      = entity_get<Move>(entity);
-        
         if (distance(to_v2(transform.position), move.destination) < 0.1f)
         {
             reset_movement(transform, move);
@@ -85,7 +133,7 @@ ListenerAction game_update()
         {
             transform.position += to_v3(move.velocity * delta_seconds());
         }
-    }
+    });
 
     return ListenerAction::StayListening;
 }
\ No newline at end of file
@@ -1,2 +1,3 @@
 include "app/premake5.lua"
-include "bb/premake5.lua"
\ No newline at end of file
+include "bb/premake5.lua"
+include "tests/premake5.lua"
\ No newline at end of file
@@ -22,24 +22,18 @@ void register_bullet_component()
 
 EntityID bullet_spawn(const Vector3& pos, const Vector3& dir)
 {
-    if (!entity_valid(game->entity_bullet_preset))
+    if (!game->bullet_recycler.prefab)
     {
         NIT_CHECK(false);
         return NULL_ENTITY;
     }
     
-    EntityID instance = entity_clone(game->entity_bullet_preset, pos);
+    EntityID instance = entity_recycler_acquire(&game->bullet_recycler, pos);
 
     auto& bullet  = entity_get<Bullet>(instance);
     bullet.dir = dir;
     
     auto& rb = entity_get<Rigidbody2D>(instance);
-    auto& sprite = entity_get<Sprite>(instance);
-    
-    bullet.enabled      = true;
-    rb.enabled          = true;
-    rb.follow_transform = true;
-    sprite.visible      = true;
     
     //rigidbody_add_force(rb, to_v2(dir * 20.f), to_v2(pos));
     rigidbody_set_velocity(rb, to_v2(dir * .0001f));
@@ -56,22 +50,32 @@ void bullet_start()
     rb.enabled     = false;
     sprite.visible = false;
     bullet.enabled = false;
+
+    // The preset stays disabled in the scene, the spawned bullets start enabled
+    prefab_load(&game->bullet_prefab, game->entity_bullet_preset);
+    prefab_get<Rigidbody2D>(&game->bullet_prefab)->enabled          = true;
+    prefab_get<Rigidbody2D>(&game->bullet_prefab)->follow_transform = true;
+    prefab_get<Sprite>(&game->bullet_prefab)->visible               = true;
+    prefab_get<Bullet>(&game->bullet_prefab)->enabled               = true;
+    entity_recycler_load(&game->bullet_recycler, &game->bullet_prefab, BULLET_WARM_UP_COUNT);
 }
 
 void bullet_update()
 {
-    for (EntityID entity : entity_get_group<BULLET_GROUP_SIGNATURE>().entities)
+    for (auto [entity, transform, sprite, movement, bullet, rb, collider] : entity_view<BULLET_GROUP_SIGNATURE>(true))
     {
-        auto& bullet  = entity_get<Bullet>(entity);
-
         if (!bullet.enabled)
         {
             continue;
         }
         
-        auto& movement  = entity_get<Movement>(entity);
-        auto& transform = entity_get<Transform>(entity);
-        
         transform.position += to_v3(multiply(movement.speed, to_v2(bullet.dir)) * delta_seconds());
+        bullet.timer += delta_seconds();
+
+        // Parking only disables the entity and the destroys of a full recycler are deferred, the view stays valid
+        if (bullet.timer >= bullet.life)
+        {
+            entity_recycler_release(&game->bullet_recycler, entity);
+        }
     }
 }
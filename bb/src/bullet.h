@@ -5,10 +5,13 @@ struct Bullet
     bool    enabled = true;
     Vector3 dir     = V3_UP;
     f32     damage  = 10.f;
+    f32     life    = 3.f; // Seconds until the bullet goes back to the recycler
+    f32     timer   = 0.f;
 };
 
 #define BULLET_GROUP_SIGNATURE Transform, Sprite, Movement, Bullet, Rigidbody2D, CircleCollider
 #define ENTITY_NAME_BULLET_PRESET "BulletPreset"
+#define BULLET_WARM_UP_COUNT 256
 
 void register_bullet_component();
 
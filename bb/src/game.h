@@ -5,10 +5,12 @@
 
 struct Game
 {
-    EntityID    entity_player        = NULL_ENTITY;
-    EntityID    entity_bullet_preset = NULL_ENTITY;
-    AssetHandle scene_game           = {};
-    AssetHandle scene_presets        = {};
+    EntityID       entity_player        = NULL_ENTITY;
+    EntityID       entity_bullet_preset = NULL_ENTITY;
+    Prefab         bullet_prefab        = {};
+    EntityRecycler bullet_recycler      = {};
+    AssetHandle    scene_game           = {};
+    AssetHandle    scene_presets        = {};
 };
 
 inline Game* game = nullptr;
@@ -33,6 +33,12 @@ void hittable_update()
 
         for (TriggerEnterEvent& enter_event : events.enter_events)
         {
+            // The events keep the handles, the entities could have been destroyed since the step
+            if (!entity_valid(enter_event.trigger_entity) || !entity_valid(enter_event.visitor_entity))
+            {
+                continue;
+            }
+            
             bool take_damage = entity_has<Health>(enter_event.trigger_entity);
             take_damage     &= entity_has<Bullet>(enter_event.visitor_entity);
             
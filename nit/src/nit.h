@@ -17,6 +17,11 @@
 #include "nit/core/asset.h"
 
 #include "nit/entity/entity.h"
+#include "nit/entity/archetype.h"
+#include "nit/entity/entity_view.h"
+#include "nit/entity/entity_commands.h"
+#include "nit/entity/prefab.h"
+#include "nit/entity/entity_recycler.h"
 #include "nit/entity/scene.h"
 #include "nit/entity/entity_utils.h"
 
@@ -75,6 +75,8 @@ namespace nit
             audio_registry->context = open_al_context;
             audio_registry->device  = open_al_device;
 
+            audio_registry->audio_sources.tag = MemoryTag::Audio;
+            audio_registry->audio_buffers.tag = MemoryTag::Audio;
             pool_load<AudioSourceData>(&audio_registry->audio_sources, 100);
             pool_load<AudioBufferData>(&audio_registry->audio_buffers, 100);
             
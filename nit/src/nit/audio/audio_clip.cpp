@@ -135,13 +135,13 @@ namespace nit
 
         //TODO: Not multi-thread friendly
         static u32 max_buffer_size = 10000;
-        static char* data = new char[max_buffer_size]; 
+        static char* data = static_cast<char*>(memory_alloc(MemoryTag::Audio, max_buffer_size)); 
         
         if (size > max_buffer_size)
         {
             max_buffer_size = size;
-            delete [] data;
-            data = new char[max_buffer_size];
+            memory_free(data);
+            data = static_cast<char*>(memory_alloc(MemoryTag::Audio, max_buffer_size));
         }
 
         std::fill_n(data, max_buffer_size, 0);
@@ -440,6 +440,7 @@ namespace nit
             }
         }
         
+        NIT_PROFILE_SCOPE_DETAIL("Asset Load", info->name);
         info->loaded = true;
         load(asset.type, pool_get_raw_data(&pool->data_pool, asset.data_id));
     }
@@ -22,8 +22,9 @@ namespace nit
 #ifdef NIT_EDITOR_ENABLED
         set_draw_editor_function  (type,  args.fn_draw_editor);
 #endif
+        asset_pool->data_pool.tag = MemoryTag::Asset;
         pool_load<T>(&asset_pool->data_pool, args.max_elements);
-        asset_pool->asset_infos = new AssetInfo[args.max_elements];
+        asset_pool->asset_infos = memory_new_array<AssetInfo>(MemoryTag::Asset, args.max_elements);
     }
     
     template<typename T>
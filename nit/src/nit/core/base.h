@@ -40,6 +40,7 @@ NIT_PRINT("\x1B[93m"); NIT_PRINTLN(__VA_ARGS__); NIT_PRINT("\033[0m")
 NIT_PRINT("\x1B[91m"); NIT_PRINTLN(__VA_ARGS__); NIT_PRINT("\033[0m")
 
 #define NIT_EDITOR_ENABLED
+#define NIT_PROFILER_ENABLED
 
 #else
 
@@ -1,6 +1,7 @@
 #include "engine.h"
 
 #include "entity/scene.h"
+#include "entity/entity_commands.h"
 
 #include "render/draw_system.h"
 #include "render/render_api.h"
@@ -57,6 +58,15 @@ namespace nit
 
         static Engine engine_instance;
         engine_set_instance(&engine_instance);
+
+        // Named so the profiler shows the stages and their listeners
+        static const char* stage_names[] = { "Init", "Start", "Update", "FixedUpdate", "LateUpdate", "PreDraw", "Draw", "PostDraw", "End" };
+        static_assert(std::size(stage_names) == (u8) Stage::Count);
+
+        for (u8 stage = 0; stage < (u8) Stage::Count; ++stage)
+        {
+            engine->events[stage].name = stage_names[stage];
+        }
     }
     
     f32 delta_seconds()
@@ -98,11 +108,124 @@ namespace nit
         return engine->events[(u8) stage];
     }
 
+    void engine_system_access(const EngineListener& listener, const EntitySignature& reads, const EntitySignature& writes)
+    {
+        engine_try_lazy_create();
+        NIT_CHECK_MSG(!delegate_empty(listener), "Trying to declare the access of an empty listener!");
+        SystemAccess& access = engine->system_access[listener.function_ptr];
+        access.reads  = reads;
+        access.writes = writes;
+        
+        // The validity bit is set in every signature, it should not count as a conflict
+        access.reads.set(0, false);
+        access.writes.set(0, false);
+    }
+
+    static bool systems_conflict(const SystemAccess& a, const SystemAccess& b)
+    {
+        return (a.writes & (b.reads | b.writes)).any() || (b.writes & a.reads).any();
+    }
+
+    struct SystemRun
+    {
+        EngineListener listener;
+        ListenerAction result = ListenerAction::StayListening;
+    };
+
+    static void run_systems(void* data, u32 begin, u32 end)
+    {
+        SystemRun* runs = static_cast<SystemRun*>(data);
+
+        for (u32 i = begin; i < end; ++i)
+        {
+            NIT_PROFILE_SCOPE_ADDRESS("Listener", runs[i].listener.function_ptr);
+            runs[i].result = runs[i].listener.function_ptr();
+        }
+    }
+
+    static void run_system_batch(Array<SystemRun>& runs, u32 begin, u32 end)
+    {
+        if (end - begin <= 1)
+        {
+            run_systems(runs.data(), begin, end);
+            return;
+        }
+
+        JobCounter counter;
+        entity_begin_concurrent_systems();
+
+        for (u32 i = begin; i < end; ++i)
+        {
+            job_schedule({ run_systems, runs.data(), i, i + 1, &counter });
+        }
+
+        job_wait(&counter);
+        entity_end_concurrent_systems();
+    }
+
+    void engine_broadcast_concurrent(Stage stage)
+    {
+        EngineEvent& event = engine_event(stage);
+
+        if (event.listeners.size() <= 1 || job_thread_count() <= 1)
+        {
+            event_broadcast(event);
+            return;
+        }
+
+        NIT_PROFILE_SCOPE(event.name);
+        static Array<SystemRun> runs;
+        runs.clear();
+
+        for (const EngineListener& listener : event.listeners)
+        {
+            runs.push_back({ listener });
+        }
+
+        SystemAccess batch_access;
+        u32 batch_begin = 0;
+
+        for (u32 i = 0; i < runs.size(); ++i)
+        {
+            auto it = engine->system_access.find(runs[i].listener.function_ptr);
+
+            if (it == engine->system_access.end())
+            {
+                run_system_batch(runs, batch_begin, i);
+                run_systems(runs.data(), i, i + 1);
+                batch_begin  = i + 1;
+                batch_access = {};
+                continue;
+            }
+
+            if (systems_conflict(batch_access, it->second))
+            {
+                run_system_batch(runs, batch_begin, i);
+                batch_begin  = i;
+                batch_access = {};
+            }
+
+            batch_access.reads  |= it->second.reads;
+            batch_access.writes |= it->second.writes;
+        }
+
+        run_system_batch(runs, batch_begin, (u32) runs.size());
+
+        for (const SystemRun& run : runs)
+        {
+            if (run.result == ListenerAction::StopListening)
+            {
+                event_remove_listener(event, run.listener);
+            }
+        }
+    }
+
     void engine_init(VoidFunc on_init)
     {
         engine_try_lazy_create();
         
         NIT_LOG_TRACE("Creating application...");
+        NIT_PROFILE_THREAD("Main");
         
         window_set_instance(&engine->window);
         window_init();
@@ -110,6 +233,9 @@ namespace nit
         type_registry_set_instance(&engine->type_registry);
         type_registry_init();
 
+        job_system_set_instance(&engine->job_system);
+        job_system_init();
+
         entity_registry_set_instance(&engine->entity_registry);
         entity_registry_init();
         
@@ -173,6 +299,7 @@ namespace nit
         }
         
         event_broadcast(engine_event(Stage::Init));
+        entity_flush_events();
         
         asset_registry_deserialize();
 
@@ -187,14 +314,24 @@ namespace nit
         engine->frame_count      = 0;
         engine->acc_fixed_delta  = engine->fixed_delta_seconds;
         engine->last_time = window_get_time();
+        engine->heap_allocations = memory_heap_allocations();
         
         NIT_LOG_TRACE("Application created!");
         
         event_broadcast(engine_event(Stage::Start));
+        entity_commands_playback();
+        entity_flush_events();
         
         while(!window_should_close())
         {
+            NIT_PROFILE_FRAME();
+            NIT_PROFILE_SCOPE("Frame");
             engine->frame_count++;
+            const u64 heap_allocations     = memory_heap_allocations();
+            engine->frame_heap_allocations = heap_allocations - engine->heap_allocations;
+            engine->heap_allocations       = heap_allocations;
+            frame_arena_reset();
+            entity_collect_groups();
             const f64 current_time = window_get_time();
             const f64 time_between_frames = current_time - engine->last_time;
             engine->last_time = current_time;
@@ -205,14 +342,23 @@ namespace nit
             while (engine->acc_fixed_delta >= engine->fixed_delta_seconds)
             {
                 event_broadcast(engine_event(Stage::FixedUpdate));
+                entity_commands_playback();
+                entity_flush_events();
                 engine->acc_fixed_delta -= engine->fixed_delta_seconds;
             }
             
-            event_broadcast(engine_event(Stage::Update));
-            event_broadcast(engine_event(Stage::LateUpdate));
+            engine_broadcast_concurrent(Stage::Update);
+            entity_commands_playback();
+            entity_flush_events();
+            engine_broadcast_concurrent(Stage::LateUpdate);
+            entity_commands_playback();
+            entity_flush_events();
             
-            NIT_IF_EDITOR_ENABLED(im_gui_begin());
-            NIT_IF_EDITOR_ENABLED(editor_begin());
+            {
+                NIT_PROFILE_SCOPE("Editor Begin");
+                NIT_IF_EDITOR_ENABLED(im_gui_begin());
+                NIT_IF_EDITOR_ENABLED(editor_begin());
+            }
             
             event_broadcast(engine_event(Stage::PreDraw));
 
@@ -222,13 +368,20 @@ namespace nit
             event_broadcast(engine_event(Stage::Draw));
 
             event_broadcast(engine_event(Stage::PostDraw));
+            entity_flush_events();
 
-            NIT_IF_EDITOR_ENABLED(editor_end());
-            NIT_IF_EDITOR_ENABLED(im_gui_end(window_get_size()));
+            {
+                NIT_PROFILE_SCOPE("Editor End");
+                NIT_IF_EDITOR_ENABLED(editor_end());
+                NIT_IF_EDITOR_ENABLED(im_gui_end(window_get_size()));
+            }
             
+            NIT_PROFILE_SCOPE("Window Update");
             window_update();
         }
 
         event_broadcast(engine_event(Stage::End));
+        
+        job_system_finish();
     }
 }
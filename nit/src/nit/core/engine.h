@@ -1,6 +1,7 @@
 #pragma once
 #include "nit/core/window.h"
 #include "nit/core/asset.h"
+#include "nit/core/job_system.h"
 #include "nit/render/renderer_2d.h"
 #include "nit/render/imgui_renderer.h"
 #include "nit/entity/entity.h"
@@ -31,12 +32,25 @@ namespace nit
 
     using EngineEvent    = Event<>;
     using EngineListener = Listener<>;
+
+    // Components that a system reads and writes. Update and LateUpdate systems that declare their access run
+    // concurrently in the job system with the neighbour systems that don't conflict with them. Systems without
+    // declared access run alone, in registration order. Systems that create or destroy entities, add or remove
+    // components or touch shared state other than their components should not declare access.
+    struct SystemAccess
+    {
+        EntitySignature reads;
+        EntitySignature writes;
+    };
     
     struct Engine
     {
         EngineEvent    events[(u8) Stage::Count];
         
+        Map<ListenerAction(*)(), SystemAccess> system_access;
+        
         Window         window;
+        JobSystem      job_system;
         TypeRegistry   type_registry;
         RenderObjects  render_objects;
         Renderer2D     renderer_2d;
@@ -55,6 +69,9 @@ namespace nit
         f64 acc_fixed_delta  = 0;
         f64 last_time        = 0;
 
+        u64 heap_allocations       = 0; // Total at the start of the current frame, see memory_heap_allocations
+        u64 frame_heap_allocations = 0; // Heap allocations of the previous frame
+
         f64 max_delta_time      = 1.f / 15.f;
         f64 fixed_delta_seconds = 0.0166;
     };
@@ -65,6 +82,11 @@ namespace nit
     f32          delta_seconds();
     f32          fixed_delta_seconds();
     EngineEvent& engine_event(Stage stage);
+    void         engine_system_access(const EngineListener& listener, const EntitySignature& reads, const EntitySignature& writes);
     void         engine_init(VoidFunc on_init = nullptr);
     Vector2      engine_window_size();
+
+    // Like event_broadcast but consecutive systems with declared, non conflicting access run at the same time. The
+    // engine loop uses it for Update and LateUpdate.
+    void         engine_broadcast_concurrent(Stage stage);
 }
@@ -70,10 +70,17 @@ namespace nit
     template<typename... Args>
     using Listener = Delegate<ListenerAction(Args...)>; 
     
+    // Listeners can be added or removed while the event is broadcasting. The removed ones are left empty and get
+    // compacted when the outermost broadcast finishes, the added ones are called from the next broadcast.
+    // Broadcasts of named events and each of their listeners are profiled, unnamed ones are not to keep the
+    // frequent events (components added or removed) cheap.
     template<typename... Args>
     struct Event
     {
         Array<Listener<Args...>> listeners;
+        const char*              name              = nullptr; // String literal
+        u32                      broadcasting      = 0;
+        bool                     removed_listeners = false;
     };
 
     template<typename... Args>
@@ -118,6 +125,12 @@ namespace nit
         {
             return;
         }
+        if (event.broadcasting)
+        {
+            delegate_unbind(*it);
+            event.removed_listeners = true;
+            return;
+        }
         event.listeners.erase(it);
     }
     
@@ -130,9 +143,19 @@ namespace nit
     template<typename... Args>
     void event_remove_all_listeners(Event<Args...>& event)
     {
+        if (event.broadcasting)
+        {
+            for (Listener<Args...>& listener : event.listeners)
+            {
+                delegate_unbind(listener);
+            }
+            event.removed_listeners = true;
+            return;
+        }
         event.listeners.clear();
     }
 
+    // Does not allocate, listeners that stop listening are removed in place
     template<typename... Args>
     void event_broadcast(Event<Args...>& event, Args... args)
     {
@@ -141,24 +164,85 @@ namespace nit
             return;
         }
         
-        Array<Listener<Args...>> listeners_to_remove;
-        listeners_to_remove.reserve(event.listeners.size());
+        NIT_PROFILE_SCOPE(event.name);
+        const u32 count = (u32) event.listeners.size();
+        ++event.broadcasting;
         
-        for (Listener<Args...>& listener : event.listeners)
+        for (u32 i = 0; i < count; ++i)
         {
-            switch (listener.function_ptr(std::forward<Args>(args)...))
+            // Copied, listeners added during the broadcast can reallocate the array
+            const Listener<Args...> listener = event.listeners[i];
+
+            if (delegate_empty(listener))
+            {
+                continue;
+            }
+            
+            NIT_PROFILE_SCOPE_ADDRESS(event.name ? "Listener" : nullptr, listener.function_ptr);
+            switch (listener.function_ptr(args...))
             {
             case ListenerAction::StayListening:
                 break;
             case ListenerAction::StopListening:
-                listeners_to_remove.push_back(listener);
+                delegate_unbind(event.listeners[i]);
+                event.removed_listeners = true;
                 break;
             }
         }
 
-        for (Listener<Args...>& listener : listeners_to_remove)
+        if (--event.broadcasting == 0 && event.removed_listeners)
+        {
+            std::erase_if(event.listeners, [](const Listener<Args...>& listener) { return delegate_empty(listener); });
+            event.removed_listeners = false;
+        }
+    }
+
+    // Queued mode of an event. The items get appended to a buffer and event_queue_flush delivers all of them to the
+    // listeners at once as a contiguous span (items, count), so a listener can process the batch in one pass
+    // instead of being called per item. The buffers keep their capacity between flushes so queueing does not
+    // allocate once warmed up. Items pushed while nobody listens are dropped, items pushed while flushing are
+    // delivered by the next flush.
+    template<typename T>
+    struct EventQueue
+    {
+        Event<const T*, u32> event;
+        Array<T>             items;
+        Array<T>             flushing;
+    };
+
+    template<typename T>
+    void event_queue_push(EventQueue<T>& queue, const T& item)
+    {
+        if (!event_empty(queue.event))
+        {
+            queue.items.push_back(item);
+        }
+    }
+
+    // prepare(Array<T>&) can filter or reorder the batch before the listeners get it
+    template<typename T, typename F>
+    void event_queue_flush(EventQueue<T>& queue, F&& prepare)
+    {
+        // A listener flushing the queue again would swap the batch it is reading
+        if (queue.items.empty() || queue.event.broadcasting)
+        {
+            return;
+        }
+        
+        std::swap(queue.items, queue.flushing);
+        prepare(queue.flushing);
+
+        if (!queue.flushing.empty())
         {
-            event_remove_listener(event, listener);
+            event_broadcast<const T*, u32>(queue.event, queue.flushing.data(), (u32) queue.flushing.size());
         }
+        
+        queue.flushing.clear();
+    }
+
+    template<typename T>
+    void event_queue_flush(EventQueue<T>& queue)
+    {
+        event_queue_flush(queue, [](Array<T>&) {});
     }
 }
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include "job_system.h"
+
+namespace nit
+{
+    JobSystem* job_system = nullptr;
+
+    static thread_local u32 thread_index = 0;
+
+    void job_system_set_instance(JobSystem* instance)
+    {
+        if (!instance || job_system)
+        {
+            NIT_CHECK(false);
+            return;
+        }
+
+        job_system = instance;
+    }
+
+    bool job_system_has_instance()
+    {
+        return job_system != nullptr;
+    }
+
+    JobSystem* job_system_get_instance()
+    {
+        if (!job_system)
+        {
+            NIT_CHECK(false);
+            return nullptr;
+        }
+
+        return job_system;
+    }
+
+    static bool job_try_pop(u32 index, Job& job)
+    {
+        const u32 thread_count = job_thread_count();
+
+        {
+            JobQueue& own = job_system->queues[index];
+            std::lock_guard lock(own.mutex);
+
+            if (!own.jobs.empty())
+            {
+                job = own.jobs.back();
+                own.jobs.pop_back();
+                --job_system->queued_jobs;
+                return true;
+            }
+        }
+
+        for (u32 i = 1; i < thread_count; ++i)
+        {
+            JobQueue& victim = job_system->queues[(index + i) % thread_count];
+            std::lock_guard lock(victim.mutex);
+
+            if (!victim.jobs.empty())
+            {
+                job = victim.jobs.front();
+                victim.jobs.pop_front();
+                --job_system->queued_jobs;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    static void job_run(const Job& job)
+    {
+        job.func(job.data, job.begin, job.end);
+
+        if (job.counter)
+        {
+            job.counter->pending.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    static void worker_loop(u32 index)
+    {
+        thread_index = index;
+        NIT_PROFILE_THREAD("Worker " + std::to_string(index));
+
+        while (job_system->running)
+        {
+            Job job;
+
+            if (job_try_pop(index, job))
+            {
+                job_run(job);
+                continue;
+            }
+
+            std::unique_lock lock(job_system->sleep_mutex);
+            job_system->wake_condition.wait(lock, [] { return job_system->queued_jobs > 0 || !job_system->running; });
+        }
+    }
+
+    void job_system_init()
+    {
+        if (!job_system_has_instance())
+        {
+            static JobSystem instance;
+            job_system_set_instance(&instance);
+        }
+
+        if (job_system->worker_count == U32_MAX)
+        {
+            const u32 hardware_threads = std::thread::hardware_concurrency();
+            job_system->worker_count = hardware_threads > 1 ? hardware_threads - 1 : 0;
+        }
+
+        job_system->queues  = new JobQueue[job_system->worker_count + 1];
+        job_system->running = true;
+
+        for (u32 i = 1; i <= job_system->worker_count; ++i)
+        {
+            job_system->workers.emplace_back(worker_loop, i);
+        }
+    }
+
+    void job_system_finish()
+    {
+        if (!job_system_has_instance())
+        {
+            NIT_CHECK(false);
+            return;
+        }
+
+        {
+            std::lock_guard lock(job_system->sleep_mutex);
+            job_system->running = false;
+        }
+
+        job_system->wake_condition.notify_all();
+
+        for (std::thread& worker : job_system->workers)
+        {
+            worker.join();
+        }
+
+        job_system->workers.clear();
+        delete[] job_system->queues;
+        job_system->queues = nullptr;
+    }
+
+    u32 job_thread_count()
+    {
+        return job_system && job_system->queues ? job_system->worker_count + 1 : 1;
+    }
+
+    u32 job_thread_index()
+    {
+        return thread_index;
+    }
+
+    void job_schedule(const Job& job)
+    {
+        NIT_CHECK_MSG(job.func, "Trying to schedule an empty job!");
+
+        if (job.counter)
+        {
+            job.counter->pending.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (job_thread_count() <= 1)
+        {
+            job_run(job);
+            return;
+        }
+
+        {
+            JobQueue& queue = job_system->queues[thread_index];
+            std::lock_guard lock(queue.mutex);
+            queue.jobs.push_back(job);
+            ++job_system->queued_jobs;
+        }
+
+        {
+            // Taking the lock prevents the wake up from getting lost between the predicate check and the wait
+            std::lock_guard lock(job_system->sleep_mutex);
+        }
+
+        job_system->wake_condition.notify_one();
+    }
+
+    void job_wait(JobCounter* counter)
+    {
+        NIT_CHECK(counter);
+
+        while (counter->pending.load(std::memory_order_acquire) > 0)
+        {
+            Job job;
+
+            if (job_system && job_system->queues && job_try_pop(thread_index, job))
+            {
+                job_run(job);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace nit
+{
+    using JobFunc = void(*)(void* data, u32 begin, u32 end);
+
+    // Tracks the jobs of a batch, job_wait returns when it reaches zero
+    struct JobCounter
+    {
+        std::atomic<u32> pending = 0;
+    };
+
+    struct Job
+    {
+        JobFunc     func    = nullptr;
+        void*       data    = nullptr;
+        u32         begin   = 0;
+        u32         end     = 0;
+        JobCounter* counter = nullptr;
+    };
+
+    // The owner thread pushes and pops from the back, idle threads steal from the front
+    struct JobQueue
+    {
+        std::mutex      mutex;
+        std::deque<Job> jobs;
+    };
+
+    struct JobSystem
+    {
+        u32                     worker_count = U32_MAX; // Threads besides the main one, U32_MAX uses one per hardware thread minus the main one
+        Array<std::thread>      workers;
+        JobQueue*               queues       = nullptr; // One per thread, index 0 belongs to the main thread
+        std::atomic<bool>       running      = false;
+        std::atomic<u32>        queued_jobs  = 0;
+        std::mutex              sleep_mutex;
+        std::condition_variable wake_condition;
+    };
+
+    void       job_system_set_instance(JobSystem* instance);
+    bool       job_system_has_instance();
+    JobSystem* job_system_get_instance();
+    void       job_system_init();
+    void       job_system_finish();
+
+    u32        job_thread_count();
+    u32        job_thread_index();
+    void       job_schedule(const Job& job);
+    void       job_wait(JobCounter* counter);
+
+    // Calls fn(i) for every i in [0, count), splitting the range in batches of batch_size that run across the
+    // workers. The calling thread helps until all of them finish. Runs inline if there are no workers.
+    template<typename F>
+    void parallel_for(u32 count, u32 batch_size, F&& fn)
+    {
+        using Fn = std::remove_reference_t<F>;
+
+        batch_size = std::max(batch_size, 1u);
+
+        if (count <= batch_size || job_thread_count() <= 1)
+        {
+            for (u32 i = 0; i < count; ++i)
+            {
+                fn(i);
+            }
+            return;
+        }
+
+        JobFunc func = [](void* data, u32 begin, u32 end)
+        {
+            Fn& batch_fn = *static_cast<Fn*>(data);
+
+            for (u32 i = begin; i < end; ++i)
+            {
+                batch_fn(i);
+            }
+        };
+
+        JobCounter counter;
+
+        for (u32 begin = 0; begin < count; begin += batch_size)
+        {
+            job_schedule({ func, (void*) &fn, begin, std::min(begin + batch_size, count), &counter });
+        }
+
+        job_wait(&counter);
+    }
+}
@@ -0,0 +1,815 @@
+#include "memory.h"
+#include <atomic>
+
+namespace nit
+{
+    void* arena_alloc(Arena* arena, u64 size, u64 alignment)
+    {
+        NIT_CHECK(arena && std::has_single_bit(alignment));
+
+        while (true)
+        {
+            if (arena->block < arena->blocks.size())
+            {
+                const ArenaBlock& block = arena->blocks[arena->block];
+                const uintptr_t base    = reinterpret_cast<uintptr_t>(block.data);
+                const uintptr_t start   = (base + arena->offset + alignment - 1) & ~(uintptr_t) (alignment - 1);
+
+                if (start + size <= base + block.size)
+                {
+                    arena->offset = start + size - base;
+                    return reinterpret_cast<void*>(start);
+                }
+
+                // The rest of the block is wasted until the next reset
+                ++arena->block;
+                arena->offset = 0;
+                continue;
+            }
+
+            const u64 block_size = std::max(arena->block_size, size + alignment);
+            arena->blocks.push_back({ new u8[block_size], block_size });
+        }
+    }
+
+    void arena_reset(Arena* arena)
+    {
+        NIT_CHECK(arena);
+        arena->peak_used = std::max(arena->peak_used, arena_used(arena));
+        arena->block     = 0;
+        arena->offset    = 0;
+    }
+
+    void arena_free(Arena* arena)
+    {
+        NIT_CHECK(arena);
+
+        for (ArenaBlock& block : arena->blocks)
+        {
+            delete[] block.data;
+        }
+
+        *arena = {};
+    }
+
+    u64 arena_used(const Arena* arena)
+    {
+        NIT_CHECK(arena);
+        u64 used = arena->offset;
+
+        for (u32 i = 0; i < arena->block && i < arena->blocks.size(); ++i)
+        {
+            used += arena->blocks[i].size;
+        }
+
+        return used;
+    }
+
+    // Gives the blocks back when the thread or the program ends
+    struct OwnedArena
+    {
+        Arena arena;
+        ~OwnedArena() { arena_free(&arena); }
+    };
+
+    Arena* frame_arena()
+    {
+        static OwnedArena owned;
+        return &owned.arena;
+    }
+
+    void frame_arena_reset()
+    {
+        arena_reset(frame_arena());
+    }
+
+    Arena* temp_arena()
+    {
+        static thread_local OwnedArena owned;
+        return &owned.arena;
+    }
+
+#ifdef NIT_ALLOCATION_COUNTER
+    static std::atomic<u64> heap_allocations = 0;
+#endif
+
+    u64 memory_heap_allocations()
+    {
+#ifdef NIT_ALLOCATION_COUNTER
+        return heap_allocations.load(std::memory_order_relaxed);
+#else
+        return 0;
+#endif
+    }
+
+    const char* memory_tag_name(MemoryTag tag)
+    {
+        switch (tag)
+        {
+        case MemoryTag::General: return "General";
+        case MemoryTag::Entity:  return "Entity";
+        case MemoryTag::Render:  return "Render";
+        case MemoryTag::Asset:   return "Asset";
+        case MemoryTag::Audio:   return "Audio";
+        case MemoryTag::Physics: return "Physics";
+        case MemoryTag::Editor:  return "Editor";
+        default:                 return "Invalid";
+        }
+    }
+
+    static u64 align_up(u64 value, u64 alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    static void* heap_alloc(Allocator*, u64 size)
+    {
+        return std::malloc(size != 0 ? size : 1);
+    }
+
+    static void heap_free(Allocator*, void* memory, u64)
+    {
+        std::free(memory);
+    }
+
+    static Allocator heap = { "Heap", heap_alloc, heap_free, nullptr };
+
+    Allocator* heap_allocator()
+    {
+        return &heap;
+    }
+
+    void* allocator_alloc(Allocator* allocator, u64 size)
+    {
+        NIT_CHECK(allocator && allocator->fn_alloc);
+        void* memory = allocator->fn_alloc(allocator, size);
+        NIT_CHECK_MSG(memory, "Allocator %s out of memory!", allocator->name);
+        return memory;
+    }
+
+    void allocator_free(Allocator* allocator, void* memory, u64 size)
+    {
+        NIT_CHECK(allocator && allocator->fn_free);
+        if (memory)
+        {
+            allocator->fn_free(allocator, memory, size);
+        }
+    }
+
+    static void* block_allocator_alloc(Allocator* allocator, u64 size)
+    {
+        BlockAllocator* block_allocator = static_cast<BlockAllocator*>(allocator->user_data);
+        return size <= block_allocator->block_size ? block_alloc(block_allocator) : allocator_alloc(block_allocator->parent, size);
+    }
+
+    static void block_allocator_dealloc(Allocator* allocator, void* memory, u64 size)
+    {
+        BlockAllocator* block_allocator = static_cast<BlockAllocator*>(allocator->user_data);
+
+        if (size <= block_allocator->block_size)
+        {
+            block_free(block_allocator, memory);
+            return;
+        }
+
+        allocator_free(block_allocator->parent, memory, size);
+    }
+
+    void block_allocator_load(BlockAllocator* block_allocator, u64 block_size, u64 page_size, Allocator* parent)
+    {
+        NIT_CHECK(block_allocator && parent && block_size != 0);
+        block_allocator->allocator   = { "Block", block_allocator_alloc, block_allocator_dealloc, block_allocator };
+        block_allocator->parent      = parent;
+        block_allocator->block_size  = align_up(std::max<u64>(block_size, sizeof(void*)), Allocator::ALIGNMENT);
+        block_allocator->page_size   = std::max(page_size, block_allocator->block_size);
+        block_allocator->free_list   = nullptr;
+        block_allocator->used_blocks = 0;
+        block_allocator->pages.clear();
+    }
+
+    void block_allocator_free(BlockAllocator* block_allocator)
+    {
+        NIT_CHECK(block_allocator);
+        std::lock_guard lock(block_allocator->mutex);
+        NIT_CHECK_MSG(block_allocator->used_blocks == 0, "Freeing a block allocator with %u blocks in use!", block_allocator->used_blocks);
+
+        for (void* page : block_allocator->pages)
+        {
+            allocator_free(block_allocator->parent, page, block_allocator->page_size);
+        }
+
+        block_allocator->pages.clear();
+        block_allocator->free_list   = nullptr;
+        block_allocator->used_blocks = 0;
+    }
+
+    void* block_alloc(BlockAllocator* block_allocator)
+    {
+        NIT_CHECK(block_allocator && block_allocator->parent);
+        std::lock_guard lock(block_allocator->mutex);
+
+        if (!block_allocator->free_list)
+        {
+            u8* page = static_cast<u8*>(allocator_alloc(block_allocator->parent, block_allocator->page_size));
+            block_allocator->pages.push_back(page);
+
+            // Linked backwards so the blocks get handed out in address order
+            for (u64 i = block_allocator->page_size / block_allocator->block_size; i-- > 0;)
+            {
+                void* block = page + i * block_allocator->block_size;
+                *static_cast<void**>(block) = block_allocator->free_list;
+                block_allocator->free_list  = block;
+            }
+        }
+
+        void* block = block_allocator->free_list;
+        block_allocator->free_list = *static_cast<void**>(block);
+        ++block_allocator->used_blocks;
+        return block;
+    }
+
+    void block_free(BlockAllocator* block_allocator, void* block)
+    {
+        NIT_CHECK(block_allocator);
+        if (!block)
+        {
+            return;
+        }
+
+        std::lock_guard lock(block_allocator->mutex);
+        *static_cast<void**>(block) = block_allocator->free_list;
+        block_allocator->free_list  = block;
+        --block_allocator->used_blocks;
+    }
+
+    static u32 slab_class(u64 size)
+    {
+        return size <= SlabAllocator::MIN_SIZE ? 0 : (u32) std::bit_width(size - 1) - std::countr_zero(SlabAllocator::MIN_SIZE);
+    }
+
+    static void* slab_allocator_alloc(Allocator* allocator, u64 size)
+    {
+        SlabAllocator* slab_allocator = static_cast<SlabAllocator*>(allocator->user_data);
+
+        if (size > SlabAllocator::MAX_SIZE)
+        {
+            return allocator_alloc(slab_allocator->parent, size);
+        }
+
+        return block_alloc(&slab_allocator->classes[slab_class(size)]);
+    }
+
+    static void slab_allocator_dealloc(Allocator* allocator, void* memory, u64 size)
+    {
+        SlabAllocator* slab_allocator = static_cast<SlabAllocator*>(allocator->user_data);
+
+        if (size > SlabAllocator::MAX_SIZE)
+        {
+            allocator_free(slab_allocator->parent, memory, size);
+            return;
+        }
+
+        block_free(&slab_allocator->classes[slab_class(size)], memory);
+    }
+
+    void slab_allocator_load(SlabAllocator* slab_allocator, u64 page_size, Allocator* parent)
+    {
+        NIT_CHECK(slab_allocator && parent);
+        slab_allocator->allocator = { "Slab", slab_allocator_alloc, slab_allocator_dealloc, slab_allocator };
+        slab_allocator->parent    = parent;
+
+        for (u32 i = 0; i < SlabAllocator::CLASS_COUNT; ++i)
+        {
+            block_allocator_load(&slab_allocator->classes[i], SlabAllocator::MIN_SIZE << i, page_size, parent);
+        }
+    }
+
+    void slab_allocator_free(SlabAllocator* slab_allocator)
+    {
+        NIT_CHECK(slab_allocator);
+
+        for (BlockAllocator& block_allocator : slab_allocator->classes)
+        {
+            block_allocator_free(&block_allocator);
+        }
+    }
+
+    // Precedes the data of every block. Blocks are contiguous inside a pool, each pool ends with a used block of size
+    // 0 so the last real block never looks past it.
+    struct TlsfBlock
+    {
+        static constexpr u64 FREE      = 1;
+        static constexpr u64 PREV_FREE = 2;
+        static constexpr u64 FLAGS     = FREE | PREV_FREE;
+
+        TlsfBlock* prev_physical = nullptr; // Only valid while the previous block is free
+        u64        size_flags    = 0;       // Size of the data, the flags use the low bits
+    };
+
+    // Free blocks keep the links of their free list in the data
+    struct TlsfLinks
+    {
+        TlsfBlock* next = nullptr;
+        TlsfBlock* prev = nullptr;
+    };
+
+    static constexpr u64 TLSF_HEADER   = sizeof(TlsfBlock);
+    static constexpr u64 TLSF_MIN_SIZE = sizeof(TlsfLinks);
+    static constexpr u64 TLSF_SMALL    = TlsfAllocator::SL_COUNT * Allocator::ALIGNMENT; // Below it the classes are linear
+    static constexpr u32 TLSF_FL_SHIFT = std::countr_zero(TLSF_SMALL) - 1;
+
+    static u64        tlsf_size(const TlsfBlock* block)     { return block->size_flags & ~TlsfBlock::FLAGS; }
+    static u8*        tlsf_data(TlsfBlock* block)           { return reinterpret_cast<u8*>(block) + TLSF_HEADER; }
+    static TlsfLinks* tlsf_links(TlsfBlock* block)          { return reinterpret_cast<TlsfLinks*>(tlsf_data(block)); }
+    static TlsfBlock* tlsf_next_physical(TlsfBlock* block)  { return reinterpret_cast<TlsfBlock*>(tlsf_data(block) + tlsf_size(block)); }
+
+    static void tlsf_mapping(u64 size, u32& fl, u32& sl)
+    {
+        if (size < TLSF_SMALL)
+        {
+            fl = 0;
+            sl = (u32) (size / Allocator::ALIGNMENT);
+            return;
+        }
+
+        const u32 msb = (u32) std::bit_width(size) - 1;
+        fl = msb - TLSF_FL_SHIFT;
+        sl = (u32) (size >> (msb - TlsfAllocator::SL_BITS)) ^ TlsfAllocator::SL_COUNT;
+    }
+
+    // Rounds the size up to the next class, so any block of the class found is big enough
+    static u64 tlsf_round_up(u64 size)
+    {
+        if (size < TLSF_SMALL)
+        {
+            return size;
+        }
+
+        const u64 granularity = 1ull << (std::bit_width(size) - 1 - TlsfAllocator::SL_BITS);
+        return (size + granularity - 1) & ~(granularity - 1);
+    }
+
+    static void tlsf_insert(TlsfAllocator* tlsf_allocator, TlsfBlock* block)
+    {
+        u32 fl, sl;
+        tlsf_mapping(tlsf_size(block), fl, sl);
+
+        TlsfBlock*& head = reinterpret_cast<TlsfBlock*&>(tlsf_allocator->free_lists[fl][sl]);
+        tlsf_links(block)->prev = nullptr;
+        tlsf_links(block)->next = head;
+
+        if (head)
+        {
+            tlsf_links(head)->prev = block;
+        }
+
+        head = block;
+        tlsf_allocator->fl_bitmap     |= 1u << fl;
+        tlsf_allocator->sl_bitmap[fl] |= 1u << sl;
+    }
+
+    static void tlsf_remove(TlsfAllocator* tlsf_allocator, TlsfBlock* block)
+    {
+        u32 fl, sl;
+        tlsf_mapping(tlsf_size(block), fl, sl);
+
+        TlsfBlock*& head = reinterpret_cast<TlsfBlock*&>(tlsf_allocator->free_lists[fl][sl]);
+        TlsfLinks* links = tlsf_links(block);
+
+        if (links->prev)
+        {
+            tlsf_links(links->prev)->next = links->next;
+        }
+
+        if (links->next)
+        {
+            tlsf_links(links->next)->prev = links->prev;
+        }
+
+        if (head == block)
+        {
+            head = links->next;
+
+            if (!head)
+            {
+                tlsf_allocator->sl_bitmap[fl] &= ~(1u << sl);
+
+                if (tlsf_allocator->sl_bitmap[fl] == 0)
+                {
+                    tlsf_allocator->fl_bitmap &= ~(1u << fl);
+                }
+            }
+        }
+    }
+
+    // First free block of the class of the size or of any bigger one
+    static TlsfBlock* tlsf_find(TlsfAllocator* tlsf_allocator, u64 size)
+    {
+        u32 fl, sl;
+        tlsf_mapping(size, fl, sl);
+
+        if (fl >= TlsfAllocator::FL_COUNT)
+        {
+            return nullptr;
+        }
+
+        u32 sl_map = tlsf_allocator->sl_bitmap[fl] & (~0u << sl);
+
+        if (sl_map == 0)
+        {
+            const u32 fl_map = fl + 1 < TlsfAllocator::FL_COUNT ? tlsf_allocator->fl_bitmap & (~0u << (fl + 1)) : 0;
+
+            if (fl_map == 0)
+            {
+                return nullptr;
+            }
+
+            fl     = (u32) std::countr_zero(fl_map);
+            sl_map = tlsf_allocator->sl_bitmap[fl];
+        }
+
+        return static_cast<TlsfBlock*>(tlsf_allocator->free_lists[fl][std::countr_zero(sl_map)]);
+    }
+
+    static void tlsf_add_pool(TlsfAllocator* tlsf_allocator, u64 min_size)
+    {
+        const u64 size = align_up(std::max(tlsf_allocator->pool_size, min_size + 2 * TLSF_HEADER), Allocator::ALIGNMENT);
+        void* memory = allocator_alloc(tlsf_allocator->parent, size);
+        tlsf_allocator->pools.push_back({ memory, size });
+
+        TlsfBlock* block = static_cast<TlsfBlock*>(memory);
+        block->prev_physical = nullptr;
+        block->size_flags    = (size - 2 * TLSF_HEADER) | TlsfBlock::FREE;
+
+        TlsfBlock* sentinel = tlsf_next_physical(block);
+        sentinel->prev_physical = block;
+        sentinel->size_flags    = TlsfBlock::PREV_FREE;
+
+        tlsf_insert(tlsf_allocator, block);
+    }
+
+    static void* tlsf_alloc(Allocator* allocator, u64 size)
+    {
+        TlsfAllocator* tlsf_allocator = static_cast<TlsfAllocator*>(allocator->user_data);
+        std::lock_guard lock(tlsf_allocator->mutex);
+
+        size = std::max(align_up(size, Allocator::ALIGNMENT), TLSF_MIN_SIZE);
+        const u64 search_size = tlsf_round_up(size);
+        TlsfBlock* block = tlsf_find(tlsf_allocator, search_size);
+
+        if (!block)
+        {
+            tlsf_add_pool(tlsf_allocator, search_size);
+            block = tlsf_find(tlsf_allocator, search_size);
+
+            if (!block)
+            {
+                return nullptr;
+            }
+        }
+
+        tlsf_remove(tlsf_allocator, block);
+
+        const u64 block_size = tlsf_size(block);
+        TlsfBlock* next      = tlsf_next_physical(block);
+
+        if (block_size >= size + TLSF_HEADER + TLSF_MIN_SIZE)
+        {
+            // The rest goes back as a free block, next keeps its PREV_FREE flag
+            TlsfBlock* rest = reinterpret_cast<TlsfBlock*>(tlsf_data(block) + size);
+            rest->prev_physical = block;
+            rest->size_flags    = (block_size - size - TLSF_HEADER) | TlsfBlock::FREE;
+            next->prev_physical = rest;
+            block->size_flags   = size | (block->size_flags & TlsfBlock::PREV_FREE);
+            tlsf_insert(tlsf_allocator, rest);
+        }
+        else
+        {
+            block->size_flags &= ~TlsfBlock::FREE;
+            next->size_flags  &= ~TlsfBlock::PREV_FREE;
+        }
+
+        return tlsf_data(block);
+    }
+
+    static void tlsf_dealloc(Allocator* allocator, void* memory, u64)
+    {
+        TlsfAllocator* tlsf_allocator = static_cast<TlsfAllocator*>(allocator->user_data);
+        std::lock_guard lock(tlsf_allocator->mutex);
+
+        TlsfBlock* block = reinterpret_cast<TlsfBlock*>(static_cast<u8*>(memory) - TLSF_HEADER);
+        block->size_flags |= TlsfBlock::FREE;
+
+        if (block->size_flags & TlsfBlock::PREV_FREE)
+        {
+            TlsfBlock* prev = block->prev_physical;
+            tlsf_remove(tlsf_allocator, prev);
+            prev->size_flags += TLSF_HEADER + tlsf_size(block);
+            block = prev;
+        }
+
+        TlsfBlock* next = tlsf_next_physical(block);
+
+        if (next->size_flags & TlsfBlock::FREE)
+        {
+            tlsf_remove(tlsf_allocator, next);
+            block->size_flags += TLSF_HEADER + tlsf_size(next);
+            next = tlsf_next_physical(block);
+        }
+
+        next->prev_physical = block;
+        next->size_flags   |= TlsfBlock::PREV_FREE;
+        tlsf_insert(tlsf_allocator, block);
+    }
+
+    void tlsf_allocator_load(TlsfAllocator* tlsf_allocator, u64 pool_size, Allocator* parent)
+    {
+        NIT_CHECK(tlsf_allocator && parent);
+        tlsf_allocator->allocator = { "TLSF", tlsf_alloc, tlsf_dealloc, tlsf_allocator };
+        tlsf_allocator->parent    = parent;
+        tlsf_allocator->pool_size = pool_size;
+    }
+
+    void tlsf_allocator_free(TlsfAllocator* tlsf_allocator)
+    {
+        NIT_CHECK(tlsf_allocator);
+        std::lock_guard lock(tlsf_allocator->mutex);
+
+        for (const auto& [memory, size] : tlsf_allocator->pools)
+        {
+            allocator_free(tlsf_allocator->parent, memory, size);
+        }
+
+        tlsf_allocator->pools.clear();
+        tlsf_allocator->fl_bitmap = 0;
+        std::fill_n(tlsf_allocator->sl_bitmap, TlsfAllocator::FL_COUNT, 0u);
+        std::fill_n(&tlsf_allocator->free_lists[0][0], TlsfAllocator::FL_COUNT * TlsfAllocator::SL_COUNT, nullptr);
+    }
+
+    // Stored right before the memory returned by memory_alloc
+    struct MemoryHeader
+    {
+        Allocator* allocator = nullptr;
+        u64        size      = 0; // Requested by the user
+        u32        offset    = 0; // From the start of the block of the allocator
+        u32        alignment = 0;
+        MemoryTag  tag       = MemoryTag::General;
+    };
+
+    static constexpr u64 MEMORY_HEADER_SIZE = 32;
+    static_assert(sizeof(MemoryHeader) <= MEMORY_HEADER_SIZE && MEMORY_HEADER_SIZE % Allocator::ALIGNMENT == 0);
+
+    struct MemoryCounters
+    {
+        std::atomic<u64> bytes             = 0;
+        std::atomic<u64> peak_bytes        = 0;
+        std::atomic<u64> allocations       = 0;
+        std::atomic<u64> total_allocations = 0;
+        std::atomic<u64> budget            = 0;
+    };
+
+    static MemoryCounters memory_counters[MEMORY_TAG_COUNT];
+    static Allocator*     memory_allocators[MEMORY_TAG_COUNT] = {};
+
+    static MemoryHeader* memory_header(const void* memory)
+    {
+        return reinterpret_cast<MemoryHeader*>(const_cast<u8*>(static_cast<const u8*>(memory)) - MEMORY_HEADER_SIZE);
+    }
+
+    static u64 memory_block_size(const MemoryHeader* header)
+    {
+        return header->size + MEMORY_HEADER_SIZE + (header->alignment - Allocator::ALIGNMENT);
+    }
+
+    void memory_set_allocator(MemoryTag tag, Allocator* allocator)
+    {
+        NIT_CHECK(tag < MemoryTag::Count);
+        memory_allocators[(u32) tag] = allocator;
+    }
+
+    Allocator* memory_get_allocator(MemoryTag tag)
+    {
+        NIT_CHECK(tag < MemoryTag::Count);
+        Allocator* allocator = memory_allocators[(u32) tag];
+        return allocator ? allocator : heap_allocator();
+    }
+
+    void* memory_alloc(MemoryTag tag, u64 size, u64 alignment)
+    {
+        NIT_CHECK(tag < MemoryTag::Count && std::has_single_bit(alignment));
+        alignment = std::max(alignment, Allocator::ALIGNMENT);
+
+        Allocator* allocator = memory_get_allocator(tag);
+        const u64 block_size = size + MEMORY_HEADER_SIZE + (alignment - Allocator::ALIGNMENT);
+        u8* block = static_cast<u8*>(allocator_alloc(allocator, block_size));
+
+        if (!block)
+        {
+            return nullptr;
+        }
+
+        u8* memory = reinterpret_cast<u8*>(align_up(reinterpret_cast<uintptr_t>(block) + MEMORY_HEADER_SIZE, alignment));
+        *memory_header(memory) = { allocator, size, (u32) (memory - block), (u32) alignment, tag };
+
+        MemoryCounters& counters = memory_counters[(u32) tag];
+        const u64 bytes  = counters.bytes.fetch_add(size, std::memory_order_relaxed) + size;
+        const u64 budget = counters.budget.load(std::memory_order_relaxed);
+        u64 peak_bytes   = counters.peak_bytes.load(std::memory_order_relaxed);
+        counters.allocations.fetch_add(1, std::memory_order_relaxed);
+        counters.total_allocations.fetch_add(1, std::memory_order_relaxed);
+
+        while (bytes > peak_bytes && !counters.peak_bytes.compare_exchange_weak(peak_bytes, bytes, std::memory_order_relaxed)) {}
+
+        if (budget != 0 && bytes > budget && bytes - size <= budget)
+        {
+            NIT_LOG_WARN("%s memory over budget: %llu of %llu bytes", memory_tag_name(tag), bytes, budget);
+        }
+
+        return memory;
+    }
+
+    void* memory_realloc(MemoryTag tag, void* memory, u64 size)
+    {
+        if (!memory)
+        {
+            return memory_alloc(tag, size);
+        }
+
+        const MemoryHeader* header = memory_header(memory);
+        void* new_memory = memory_alloc(tag, size, header->alignment);
+
+        if (new_memory)
+        {
+            memcpy(new_memory, memory, std::min(size, header->size));
+            memory_free(memory);
+        }
+
+        return new_memory;
+    }
+
+    void memory_free(void* memory)
+    {
+        if (!memory)
+        {
+            return;
+        }
+
+        const MemoryHeader header = *memory_header(memory);
+        MemoryCounters& counters = memory_counters[(u32) header.tag];
+        counters.bytes.fetch_sub(header.size, std::memory_order_relaxed);
+        counters.allocations.fetch_sub(1, std::memory_order_relaxed);
+        allocator_free(header.allocator, static_cast<u8*>(memory) - header.offset, memory_block_size(&header));
+    }
+
+    u64 memory_size(const void* memory)
+    {
+        return memory ? memory_header(memory)->size : 0;
+    }
+
+    void memory_set_budget(MemoryTag tag, u64 bytes)
+    {
+        NIT_CHECK(tag < MemoryTag::Count);
+        memory_counters[(u32) tag].budget.store(bytes, std::memory_order_relaxed);
+    }
+
+    MemoryStats memory_get_stats(MemoryTag tag)
+    {
+        NIT_CHECK(tag < MemoryTag::Count);
+        const MemoryCounters& counters = memory_counters[(u32) tag];
+
+        MemoryStats stats;
+        stats.bytes             = counters.bytes.load(std::memory_order_relaxed);
+        stats.peak_bytes        = counters.peak_bytes.load(std::memory_order_relaxed);
+        stats.allocations       = counters.allocations.load(std::memory_order_relaxed);
+        stats.total_allocations = counters.total_allocations.load(std::memory_order_relaxed);
+        stats.budget            = counters.budget.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    MemoryReport memory_report()
+    {
+        MemoryReport report;
+
+        for (u32 i = 0; i < MEMORY_TAG_COUNT; ++i)
+        {
+            const MemoryStats stats = memory_get_stats((MemoryTag) i);
+            report.tags[i] = stats;
+            report.total.bytes             += stats.bytes;
+            report.total.peak_bytes        += stats.peak_bytes;
+            report.total.allocations       += stats.allocations;
+            report.total.total_allocations += stats.total_allocations;
+            report.total.budget            += stats.budget;
+        }
+
+        report.heap_allocations = memory_heap_allocations();
+        report.frame_arena_peak = frame_arena()->peak_used;
+        return report;
+    }
+
+    static void write_json_stats(StringStream& stream, const MemoryStats& stats)
+    {
+        stream << "{ \"bytes\": "             << stats.bytes
+               << ", \"peak_bytes\": "        << stats.peak_bytes
+               << ", \"allocations\": "       << stats.allocations
+               << ", \"total_allocations\": " << stats.total_allocations
+               << ", \"budget\": "            << stats.budget << " }";
+    }
+
+    String memory_report_to_json(const MemoryReport& report)
+    {
+        StringStream stream;
+        stream << "{\n  \"tags\": {\n";
+
+        for (u32 i = 0; i < MEMORY_TAG_COUNT; ++i)
+        {
+            stream << "    \"" << memory_tag_name((MemoryTag) i) << "\": ";
+            write_json_stats(stream, report.tags[i]);
+            stream << (i + 1 < MEMORY_TAG_COUNT ? ",\n" : "\n");
+        }
+
+        stream << "  },\n  \"total\": ";
+        write_json_stats(stream, report.total);
+        stream << ",\n  \"heap_allocations\": " << report.heap_allocations;
+        stream << ",\n  \"frame_arena_peak\": " << report.frame_arena_peak << "\n}\n";
+        return stream.str();
+    }
+
+    bool memory_report_dump(const String& path)
+    {
+        std::ofstream file(path);
+
+        if (!file)
+        {
+            NIT_CHECK_MSG(false, "Could not open %s!", path.c_str());
+            return false;
+        }
+
+        file << memory_report_to_json(memory_report());
+        return (bool) file;
+    }
+}
+
+#ifdef NIT_ALLOCATION_COUNTER
+// Every replaceable form of the global operator new and delete goes through these two, so the array, nothrow and
+// over aligned allocations are counted too and always freed by the matching function
+static void* counted_alloc(std::size_t size, std::size_t alignment)
+{
+    nit::heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    size = size != 0 ? size : 1;
+
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    {
+        return std::malloc(size);
+    }
+
+#ifdef NIT_PLATFORM_WINDOWS
+    return _aligned_malloc(size, alignment);
+#else
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+}
+
+static void counted_free(void* memory, [[maybe_unused]] std::size_t alignment)
+{
+#ifdef NIT_PLATFORM_WINDOWS
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    {
+        _aligned_free(memory);
+        return;
+    }
+#endif
+    std::free(memory);
+}
+
+static void* counted_new(std::size_t size, std::size_t alignment)
+{
+    if (void* memory = counted_alloc(size, alignment))
+    {
+        return memory;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new  (std::size_t size)                                                             { return counted_new(size, 0); }
+void* operator new[](std::size_t size)                                                             { return counted_new(size, 0); }
+void* operator new  (std::size_t size, std::align_val_t alignment)                                 { return counted_new(size, (std::size_t) alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment)                                 { return counted_new(size, (std::size_t) alignment); }
+void* operator new  (std::size_t size, const std::nothrow_t&) noexcept                             { return counted_alloc(size, 0); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept                             { return counted_alloc(size, 0); }
+void* operator new  (std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return counted_alloc(size, (std::size_t) alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return counted_alloc(size, (std::size_t) alignment); }
+
+void operator delete  (void* memory) noexcept                                                    { counted_free(memory, 0); }
+void operator delete[](void* memory) noexcept                                                    { counted_free(memory, 0); }
+void operator delete  (void* memory, std::size_t) noexcept                                       { counted_free(memory, 0); }
+void operator delete[](void* memory, std::size_t) noexcept                                       { counted_free(memory, 0); }
+void operator delete  (void* memory, const std::nothrow_t&) noexcept                             { counted_free(memory, 0); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept                             { counted_free(memory, 0); }
+void operator delete  (void* memory, std::align_val_t alignment) noexcept                        { counted_free(memory, (std::size_t) alignment); }
+void operator delete[](void* memory, std::align_val_t alignment) noexcept                        { counted_free(memory, (std::size_t) alignment); }
+void operator delete  (void* memory, std::size_t, std::align_val_t alignment) noexcept           { counted_free(memory, (std::size_t) alignment); }
+void operator delete[](void* memory, std::size_t, std::align_val_t alignment) noexcept           { counted_free(memory, (std::size_t) alignment); }
+void operator delete  (void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept { counted_free(memory, (std::size_t) alignment); }
+void operator delete[](void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept { counted_free(memory, (std::size_t) alignment); }
+#endif
\ No newline at end of file
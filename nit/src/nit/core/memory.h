@@ -0,0 +1,227 @@
+#pragma once
+#include <mutex>
+
+namespace nit
+{
+    struct ArenaBlock
+    {
+        u8* data = nullptr;
+        u64 size = 0;
+    };
+
+    // Bump allocator, an allocation is an offset increment and everything gets released at once with arena_reset or
+    // when an ArenaScope ends. Full blocks are chained and kept after a reset, so a warmed up arena does not touch
+    // the heap. Destructors of the objects allocated in it are not called.
+    struct Arena
+    {
+        Array<ArenaBlock> blocks;
+        u32               block      = 0; // Block being bumped
+        u64               offset     = 0; // First free byte of the current block
+        u64               block_size = 64 * 1024;
+        u64               peak_used  = 0; // Highest arena_used seen by arena_reset
+    };
+
+    void* arena_alloc(Arena* arena, u64 size, u64 alignment = alignof(std::max_align_t));
+    void  arena_reset(Arena* arena);
+    void  arena_free(Arena* arena);
+    u64   arena_used(const Arena* arena);
+
+    // Reset by the engine at the start of every frame, for temporaries that live until the end of the frame.
+    // Main thread only.
+    Arena* frame_arena();
+    void   frame_arena_reset();
+
+    // One per thread, meant to be used through ArenaScope
+    Arena* temp_arena();
+
+    // Gives back everything allocated in the arena since the scope was created
+    struct ArenaScope
+    {
+        Arena* arena  = nullptr;
+        u32    block  = 0;
+        u64    offset = 0;
+
+        explicit ArenaScope(Arena* arena = temp_arena()) : arena(arena), block(arena->block), offset(arena->offset) {}
+        ~ArenaScope() { arena->block = block; arena->offset = offset; }
+
+        ArenaScope(const ArenaScope&) = delete;
+        ArenaScope& operator=(const ArenaScope&) = delete;
+    };
+
+    // Lets the std containers allocate from an arena, deallocate does nothing
+    template<typename T>
+    struct ArenaAllocator
+    {
+        using value_type = T;
+
+        Arena* arena = nullptr;
+
+        ArenaAllocator(Arena* arena) : arena(arena) {}
+
+        template<typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+        T*   allocate(size_t count)    { return static_cast<T*>(arena_alloc(arena, count * sizeof(T), alignof(T))); }
+        void deallocate(T*, size_t)    {}
+
+        template<typename U>
+        bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+    };
+
+    template<typename T>
+    using ArenaArray  = std::vector<T, ArenaAllocator<T>>;
+    using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+    // Heap allocations (global operator new) since the start of the program. Always 0 unless the build defines
+    // NIT_ALLOCATION_COUNTER (premake5 --allocation-counter), which replaces every form of the global operator new
+    // and delete.
+    u64 memory_heap_allocations();
+
+    // Subsystem an allocation is accounted to
+    enum class MemoryTag : u8
+    {
+        General,
+        Entity,
+        Render,
+        Asset,
+        Audio,
+        Physics,
+        Editor,
+        Count
+    };
+
+    constexpr u32 MEMORY_TAG_COUNT = (u32) MemoryTag::Count;
+
+    const char* memory_tag_name(MemoryTag tag);
+
+    // Source of the memory of the tagged allocations. Implementations only have to return blocks aligned to
+    // Allocator::ALIGNMENT, bigger alignments are handled by memory_alloc. fn_free receives the size that was requested.
+    struct Allocator
+    {
+        static constexpr u64 ALIGNMENT = 16;
+
+        using FnAlloc = void* (*) (Allocator*, u64 size);
+        using FnFree  = void  (*) (Allocator*, void* memory, u64 size);
+
+        const char* name      = "";
+        FnAlloc     fn_alloc  = nullptr;
+        FnFree      fn_free   = nullptr;
+        void*       user_data = nullptr; // The allocator that implements the functions
+    };
+
+    // malloc / free
+    Allocator* heap_allocator();
+
+    void* allocator_alloc(Allocator* allocator, u64 size);
+    void  allocator_free(Allocator* allocator, void* memory, u64 size);
+
+    // Fixed size blocks carved from pages of the parent allocator, alloc and free are a pop and a push on the free
+    // list. Requests bigger than the block go straight to the parent. Pages are only given back on free.
+    struct BlockAllocator
+    {
+        Allocator    allocator;
+        Allocator*   parent      = nullptr;
+        u64          block_size  = 0;
+        u64          page_size   = 0;
+        void*        free_list   = nullptr;
+        Array<void*> pages;
+        u32          used_blocks = 0;
+        std::mutex   mutex;
+    };
+
+    void  block_allocator_load(BlockAllocator* block_allocator, u64 block_size, u64 page_size = 64 * 1024, Allocator* parent = heap_allocator());
+    void  block_allocator_free(BlockAllocator* block_allocator);
+    void* block_alloc(BlockAllocator* block_allocator);
+    void  block_free(BlockAllocator* block_allocator, void* block);
+
+    // Power of two size classes from MIN_SIZE to MAX_SIZE, each one served by a block allocator. Bigger requests
+    // go to the parent.
+    struct SlabAllocator
+    {
+        static constexpr u32 CLASS_COUNT = 8;
+        static constexpr u64 MIN_SIZE    = 16;
+        static constexpr u64 MAX_SIZE    = MIN_SIZE << (CLASS_COUNT - 1);
+
+        Allocator      allocator;
+        Allocator*     parent = nullptr;
+        BlockAllocator classes[CLASS_COUNT];
+    };
+
+    void slab_allocator_load(SlabAllocator* slab_allocator, u64 page_size = 64 * 1024, Allocator* parent = heap_allocator());
+    void slab_allocator_free(SlabAllocator* slab_allocator);
+
+    // Two level segregated fit, any size in O(1) with the free neighbours merged right away so fragmentation stays
+    // bounded. The memory comes in pools of the parent allocator that are only given back on free.
+    struct TlsfAllocator
+    {
+        static constexpr u32 SL_BITS  = 4;
+        static constexpr u32 SL_COUNT = 1 << SL_BITS;
+        static constexpr u32 FL_COUNT = 32;
+
+        Allocator               allocator;
+        Allocator*              parent                         = nullptr;
+        u64                     pool_size                      = 0;
+        u32                     fl_bitmap                      = 0;  // Bit per first level with free blocks
+        u32                     sl_bitmap[FL_COUNT]            = {}; // Bit per second level with free blocks
+        void*                   free_lists[FL_COUNT][SL_COUNT] = {};
+        Array<Pair<void*, u64>> pools;
+        std::mutex              mutex;
+    };
+
+    void tlsf_allocator_load(TlsfAllocator* tlsf_allocator, u64 pool_size = 1024 * 1024, Allocator* parent = heap_allocator());
+    void tlsf_allocator_free(TlsfAllocator* tlsf_allocator);
+
+    // Every tag allocates from the heap allocator until another one is set. Allocations remember their allocator, so
+    // it can be changed at any time, it only affects the next ones.
+    void       memory_set_allocator(MemoryTag tag, Allocator* allocator);
+    Allocator* memory_get_allocator(MemoryTag tag);
+
+    // Tagged allocations, they can be freed from any thread without knowing their tag or size
+    void* memory_alloc(MemoryTag tag, u64 size, u64 alignment = alignof(std::max_align_t));
+    void* memory_realloc(MemoryTag tag, void* memory, u64 size);
+    void  memory_free(void* memory);
+    u64   memory_size(const void* memory);
+
+    // new T[count] / delete[] counterparts, the elements are value initialized
+    template<typename T>
+    T* memory_new_array(MemoryTag tag, u64 count)
+    {
+        T* elements = static_cast<T*>(memory_alloc(tag, sizeof(T) * count, alignof(T)));
+        std::uninitialized_value_construct_n(elements, count);
+        return elements;
+    }
+
+    template<typename T>
+    void memory_delete_array(T* elements)
+    {
+        if (elements)
+        {
+            std::destroy_n(elements, memory_size(elements) / sizeof(T));
+            memory_free(elements);
+        }
+    }
+
+    struct MemoryStats
+    {
+        u64 bytes             = 0; // Live bytes
+        u64 peak_bytes        = 0;
+        u64 allocations       = 0; // Live allocations
+        u64 total_allocations = 0;
+        u64 budget            = 0; // 0 if the tag has no budget
+    };
+
+    struct MemoryReport
+    {
+        MemoryStats tags[MEMORY_TAG_COUNT];
+        MemoryStats total;              // Budget and peak are the sums of the tags
+        u64         heap_allocations = 0; // See memory_heap_allocations
+        u64         frame_arena_peak = 0;
+    };
+
+    // Going over the budget logs a warning, it does not stop the allocation. 0 removes it.
+    void         memory_set_budget(MemoryTag tag, u64 bytes);
+    MemoryStats  memory_get_stats(MemoryTag tag);
+    MemoryReport memory_report();
+    String       memory_report_to_json(const MemoryReport& report);
+    bool         memory_report_dump(const String& path);
+}
\ No newline at end of file
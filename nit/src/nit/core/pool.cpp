@@ -10,9 +10,23 @@ namespace nit
             return;
         }
         
+        if (pool->type)
+        {
+            delete_array(pool->type, pool->elements);
+            
+            for (void* chunk : pool->chunks)
+            {
+                delete_array(pool->type, chunk);
+            }
+        }
+        
         pool->type = nullptr;
-        free(pool->elements);
         pool->elements = nullptr;
+        pool->chunks.clear();
+        pool->chunk_capacity = 0;
+        pool->chunk_shift = 0;
+        pool->available_ids = {};
+        pool->next_id = 0;
         sparse_release(&pool->sparse_set);
     }
 
@@ -35,12 +49,19 @@ namespace nit
             return false;
         }
 
-        if (sparse_is_full(&pool->sparse_set))
+        if (pool->sparse_set.count == pool->sparse_set.capacity)
         {
-            pool_resize(pool, pool->sparse_set.max * 2);
+            pool_reserve(pool, sparse_next_capacity(&pool->sparse_set));
         }
         
-        set_array_raw_data(pool->type, pool->elements, sparse_insert(&pool->sparse_set, element_id), data);
+        const u32 index = sparse_insert(&pool->sparse_set, element_id);
+        
+        if (index == SparseSet::INVALID)
+        {
+            return false;
+        }
+        
+        set_array_raw_data(pool->type, pool_get_raw_data_at(pool, index), 0, data);
         return true;
     }
 
@@ -52,9 +73,8 @@ namespace nit
             return false;
         }
         
-        element_id = pool->available_ids.front();
-        pool->available_ids.pop();
-        return pool_insert_data_with_id(pool, element_id, data);
+        element_id = pool_next_id(pool);
+        return element_id != SparseSet::INVALID && pool_insert_data_with_id(pool, element_id, data);
     }
 
     SparseSetDeletion pool_delete_data(Pool* pool, u32 element_id)
@@ -65,14 +85,18 @@ namespace nit
             return { false };
         }
         
-        if (pool->self_id_management)
+        SparseSetDeletion deletion = sparse_remove(&pool->sparse_set, element_id);
+        
+        if (deletion.succeded && pool->self_id_management)
         {
-            pool->available_ids.push(element_id);
+            pool->available_ids.push(sparse_key(element_id));
+        }
+        
+        if (deletion.succeded && deletion.deleted_slot != deletion.last_slot)
+        {
+            move_array_raw_data(pool->type, pool_get_raw_data_at(pool, deletion.deleted_slot), 0, pool_get_raw_data_at(pool, deletion.last_slot), 0);
         }
         
-        SparseSetDeletion deletion = sparse_remove(&pool->sparse_set, element_id);
-        void* last_element_data = get_array_raw_data(pool->type, pool->elements, deletion.last_slot);
-        set_array_raw_data(pool->type, pool->elements, deletion.deleted_slot, last_element_data);
         return deletion;
     }
 
@@ -81,12 +105,85 @@ namespace nit
         if (!pool)
         {
             NIT_DEBUGBREAK();
+            return;
         }
 
-        resize_array(pool->type, pool->elements, pool->sparse_set.max, new_max);
         sparse_resize(&pool->sparse_set, new_max);
     }
 
+    void pool_reserve(Pool* pool, u32 new_capacity)
+    {
+        if (!pool)
+        {
+            NIT_DEBUGBREAK();
+            return;
+        }
+
+        if (new_capacity <= pool->sparse_set.capacity)
+        {
+            return;
+        }
+
+        if (pool->chunk_capacity == 0)
+        {
+            pool->elements = resize_array(pool->type, pool->elements, pool->sparse_set.capacity, new_capacity, pool->tag);
+            sparse_reserve(&pool->sparse_set, new_capacity);
+            return;
+        }
+        
+        // Existing chunks stay where they are, only new ones are appended
+        while ((u32) pool->chunks.size() * pool->chunk_capacity < new_capacity)
+        {
+            pool->chunks.push_back(new_array(pool->type, pool->chunk_capacity, pool->tag));
+        }
+        
+        sparse_reserve(&pool->sparse_set, (u32) pool->chunks.size() * pool->chunk_capacity);
+    }
+
+    PoolStats pool_get_stats(const Pool* pool)
+    {
+        if (!pool)
+        {
+            NIT_DEBUGBREAK();
+            return {};
+        }
+
+        PoolStats stats;
+        stats.count         = pool->sparse_set.count;
+        stats.capacity      = pool->sparse_set.capacity;
+        stats.max           = pool->sparse_set.max;
+        stats.chunk_count   = (u32) pool->chunks.size();
+        stats.element_bytes = pool->type ? (u64) pool->type->size * pool->sparse_set.capacity : 0;
+        stats.element_bytes += pool->chunks.capacity() * sizeof(void*);
+        stats.sparse_bytes  = sparse_memory(&pool->sparse_set);
+        stats.total_bytes   = stats.element_bytes + stats.sparse_bytes;
+        return stats;
+    }
+
+    u32 pool_next_id(Pool* pool)
+    {
+        if (!pool || !pool->self_id_management)
+        {
+            NIT_DEBUGBREAK();
+            return SparseSet::INVALID;
+        }
+
+        if (pool->next_id < pool->sparse_set.max)
+        {
+            return pool->next_id++;
+        }
+
+        if (pool->available_ids.empty())
+        {
+            NIT_CHECK_MSG(false, "Pool is full!");
+            return SparseSet::INVALID;
+        }
+
+        const u32 element_id = pool->available_ids.front();
+        pool->available_ids.pop();
+        return element_id;
+    }
+
     u32 pool_index_of(Pool* pool, u32 element_id)
     {
         if (!pool)
@@ -107,6 +204,22 @@ namespace nit
         }
         
         u32 index = sparse_search(&pool->sparse_set, element_id);
-        return index != SparseSet::INVALID ? get_array_raw_data(pool->type, pool->elements, index) : nullptr;
+        return index != SparseSet::INVALID ? pool_get_raw_data_at(pool, index) : nullptr;
+    }
+
+    void* pool_get_raw_data_at(Pool* pool, u32 index)
+    {
+        if (!pool)
+        {
+            NIT_DEBUGBREAK();
+            return nullptr;
+        }
+        
+        if (pool->chunk_capacity == 0)
+        {
+            return get_array_raw_data(pool->type, pool->elements, index);
+        }
+        
+        return get_array_raw_data(pool->type, pool->chunks[index >> pool->chunk_shift], index & (pool->chunk_capacity - 1));
     }
 }
\ No newline at end of file
@@ -2,13 +2,33 @@
 
 namespace nit
 {
+    // Elements are stored packed following the dense array of the sparse set. Contiguous pools keep them in a single
+    // array that gets reallocated on growth. Chunked pools (chunk_capacity != 0) keep them in blocks of chunk_capacity
+    // elements that never move, so pointers stay valid when the pool grows. Removing an element still moves the last
+    // one into its slot in both modes.
     struct Pool
     {
         Type*          type                = nullptr;
-        void*          elements            = nullptr;
+        void*          elements            = nullptr; // Contiguous storage, nullptr in chunked pools
+        Array<void*>   chunks              = {};      // Chunked storage
+        u32            chunk_capacity      = 0;       // Power of two, 0 for contiguous pools
+        u32            chunk_shift         = 0;
         SparseSet      sparse_set          = {};
-        Queue<u32>     available_ids       = {};
+        Queue<u32>     available_ids       = {}; // Released ids, only reused once next_id reaches the max
+        u32            next_id             = 0;
         bool           self_id_management  = false;
+        MemoryTag      tag                 = MemoryTag::General; // Set before pool_load, the sparse set gets it too
+    };
+
+    struct PoolStats
+    {
+        u32 count          = 0;
+        u32 capacity       = 0;
+        u32 max            = 0;
+        u32 chunk_count    = 0;
+        u64 element_bytes  = 0; // Allocated element storage, capacity * type size
+        u64 sparse_bytes   = 0; // Sparse pages, page table and dense ids
+        u64 total_bytes    = 0;
     };
 
     void              pool_free(Pool* pool);
@@ -17,13 +37,18 @@ namespace nit
     bool              pool_insert_data(Pool* pool, u32& element_id, void* data = nullptr);
     u32               pool_index_of(Pool* pool, u32 element_id);
     void*             pool_get_raw_data(Pool* pool, u32 element_id);
+    void*             pool_get_raw_data_at(Pool* pool, u32 index);
     SparseSetDeletion pool_delete_data(Pool* pool, u32 element_id);
     void              pool_resize(Pool* pool, u32 new_max);
+    void              pool_reserve(Pool* pool, u32 new_capacity);
+    u32               pool_next_id(Pool* pool);
+    PoolStats         pool_get_stats(const Pool* pool);
     
-    template<typename T> void pool_load(Pool* pool, u32 max_element_count, bool self_id_management = true);
+    template<typename T> void pool_load(Pool* pool, u32 max_element_count, bool self_id_management = true, u32 chunk_capacity = 0);
     template<typename T> T*   pool_insert_data_with_id(Pool* pool, u32 element_id, const T& data);
     template<typename T> T*   pool_insert_data(Pool* pool, u32& out_id, const T& data = {});
     template<typename T> T*   pool_get_data(Pool* pool, u32 element_id);
+    template<typename T> T*   pool_get_data_at(const Pool* pool, u32 index);
 }
 
 #include "nit/core/pool.inl"
\ No newline at end of file
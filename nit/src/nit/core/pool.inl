@@ -3,7 +3,7 @@
 namespace nit
 {
     template<typename T>
-    void pool_load(Pool* pool, u32 max_element_count, bool self_id_management)
+    void pool_load(Pool* pool, u32 max_element_count, bool self_id_management, u32 chunk_capacity)
     {
         if (!pool)
         {
@@ -17,18 +17,32 @@ namespace nit
         }
         
         pool->type = type_get<T>();
-        pool->elements  = new T[max_element_count];
         
+        pool->sparse_set.tag = pool->tag;
         sparse_load(&pool->sparse_set, max_element_count);
+        pool->elements = nullptr;
+        pool->chunks.clear();
+        pool->chunk_capacity = 0;
+        pool->chunk_shift = 0;
         
-        if (self_id_management)
+        if (chunk_capacity == 0)
         {
-            for (u32 i = 0; i < max_element_count; ++i)
+            pool->elements = new_array(pool->type, pool->sparse_set.capacity, pool->tag);
+        }
+        else
+        {
+            while ((1u << pool->chunk_shift) < chunk_capacity)
             {
-                pool->available_ids.push(i);
+                ++pool->chunk_shift;
             }
+            
+            // Chunks get allocated on the first insertions, the dense ids follow the chunked capacity
+            pool->chunk_capacity = 1u << pool->chunk_shift;
+            pool->sparse_set.capacity = 0;
         }
         
+        pool->available_ids = {};
+        pool->next_id = 0;
         pool->self_id_management = self_id_management;
     }
     
@@ -41,13 +55,22 @@ namespace nit
             return nullptr;
         }
 
-        if (sparse_is_full(&pool->sparse_set))
+        if (pool->sparse_set.count == pool->sparse_set.capacity)
         {
-            pool_resize(pool, pool->sparse_set.max * 2);
+            pool_reserve(pool, sparse_next_capacity(&pool->sparse_set));
         }
         
         NIT_CHECK_MSG(pool->type == type_get<T>(), "Type mismatch!");
-        return SetArrayData(pool->elements, sparse_insert(&pool->sparse_set, element_id), data);
+        const u32 index = sparse_insert(&pool->sparse_set, element_id);
+        
+        if (index == SparseSet::INVALID)
+        {
+            return nullptr;
+        }
+        
+        T* element = pool_get_data_at<T>(pool, index);
+        *element = data;
+        return element;
     }
 
     template<typename T>
@@ -59,8 +82,13 @@ namespace nit
             return nullptr;
         }
         
-        out_id = pool->available_ids.front();
-        pool->available_ids.pop();
+        out_id = pool_next_id(pool);
+        
+        if (out_id == SparseSet::INVALID)
+        {
+            return nullptr;
+        }
+        
         return pool_insert_data_with_id(pool, out_id, data);
     }
     
@@ -87,6 +115,17 @@ namespace nit
             return nullptr;
         }
         
-        return GetArrayData<T>(pool->elements, element_index);
+        return pool_get_data_at<T>(pool, element_index);
+    }
+    
+    template<typename T>
+    T* pool_get_data_at(const Pool* pool, u32 index)
+    {
+        if (pool->chunk_capacity == 0)
+        {
+            return static_cast<T*>(pool->elements) + index;
+        }
+        
+        return static_cast<T*>(pool->chunks[index >> pool->chunk_shift]) + (index & (pool->chunk_capacity - 1));
     }
 }
\ No newline at end of file
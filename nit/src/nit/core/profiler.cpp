@@ -0,0 +1,294 @@
+#include "profiler.h"
+
+#ifdef NIT_PROFILER_ENABLED
+#include <atomic>
+#include <iomanip>
+#include <mutex>
+
+namespace nit
+{
+    // Written only by its thread. head is published with release after the zone is stored, readers copy the
+    // slots behind it and drop the ones the writer could have lapped while they were copying.
+    struct ProfilerThread
+    {
+        ProfileZone      zones[PROFILER_ZONES_PER_THREAD];
+        std::atomic<u64> head  = 0; // Zones written since the thread started recording
+        u32              depth = 0;
+        u32              index = 0;
+        const char*      name  = nullptr;
+    };
+
+    // Thread buffers outlive their threads, so zones of finished workers can still be exported
+    struct ProfilerThreads
+    {
+        std::atomic<ProfilerThread*> threads[PROFILER_MAX_THREADS] = {};
+        std::atomic<u32>             count                         = 0;
+
+        ~ProfilerThreads()
+        {
+            for (std::atomic<ProfilerThread*>& thread : threads)
+            {
+                delete thread.load();
+            }
+        }
+    };
+
+    static ProfilerThreads   profiler_threads;
+    static std::atomic<bool> recording                            = true;
+    static u64               frame_starts[PROFILER_FRAME_HISTORY] = {};
+    static std::atomic<u64>  frame_head                           = 0;
+
+    static ProfilerThread* current_thread()
+    {
+        static thread_local ProfilerThread* thread = nullptr;
+
+        if (!thread)
+        {
+            const u32 index = profiler_threads.count.fetch_add(1, std::memory_order_relaxed);
+
+            if (index >= PROFILER_MAX_THREADS)
+            {
+                profiler_threads.count.store(PROFILER_MAX_THREADS, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            thread = new ProfilerThread();
+            thread->index = index;
+            profiler_threads.threads[index].store(thread, std::memory_order_release);
+        }
+
+        return thread;
+    }
+
+    u64 profiler_now_ns()
+    {
+        using Clock = std::chrono::steady_clock;
+        static const Clock::time_point start = Clock::now();
+        return (u64) std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    }
+
+    ProfileScope::ProfileScope(const char* name, const String& detail)
+    {
+        if (name && profiler_recording())
+        {
+            begin(name, profiler_intern(detail), nullptr);
+        }
+    }
+
+    void ProfileScope::begin(const char* name, const char* detail, const void* address)
+    {
+        if (!profiler_recording())
+        {
+            return;
+        }
+
+        thread = current_thread();
+
+        if (!thread)
+        {
+            return;
+        }
+
+        zone.name     = name;
+        zone.detail   = detail;
+        zone.address  = address;
+        zone.depth    = thread->depth++;
+        zone.thread   = thread->index;
+        zone.start_ns = profiler_now_ns();
+    }
+
+    void ProfileScope::end()
+    {
+        zone.end_ns = profiler_now_ns();
+        const u64 head = thread->head.load(std::memory_order_relaxed);
+        thread->zones[head % PROFILER_ZONES_PER_THREAD] = zone;
+        thread->head.store(head + 1, std::memory_order_release);
+        --thread->depth;
+    }
+
+    void profiler_set_recording(bool value)
+    {
+        recording.store(value, std::memory_order_relaxed);
+    }
+
+    bool profiler_recording()
+    {
+        return recording.load(std::memory_order_relaxed);
+    }
+
+    void profiler_frame()
+    {
+        if (!profiler_recording())
+        {
+            return;
+        }
+
+        const u64 head = frame_head.load(std::memory_order_relaxed);
+        frame_starts[head % PROFILER_FRAME_HISTORY] = profiler_now_ns();
+        frame_head.store(head + 1, std::memory_order_release);
+    }
+
+    bool profiler_last_frame(u64& start_ns, u64& end_ns)
+    {
+        const u64 head = frame_head.load(std::memory_order_acquire);
+
+        if (head < 2)
+        {
+            return false;
+        }
+
+        start_ns = frame_starts[(head - 2) % PROFILER_FRAME_HISTORY];
+        end_ns   = frame_starts[(head - 1) % PROFILER_FRAME_HISTORY];
+        return true;
+    }
+
+    const char* profiler_intern(const String& name)
+    {
+        static std::mutex mutex;
+        static UnorderedSet<String> names;
+        std::lock_guard lock(mutex);
+        return names.insert(name).first->c_str();
+    }
+
+    void profiler_set_thread_name(const char* name)
+    {
+        if (ProfilerThread* thread = current_thread())
+        {
+            thread->name = name;
+        }
+    }
+
+    void profiler_set_thread_name(const String& name)
+    {
+        profiler_set_thread_name(profiler_intern(name));
+    }
+
+    const char* profiler_thread_name(u32 thread)
+    {
+        const ProfilerThread* profiler_thread = thread < PROFILER_MAX_THREADS ? profiler_threads.threads[thread].load(std::memory_order_acquire) : nullptr;
+        return profiler_thread && profiler_thread->name ? profiler_thread->name : "Thread";
+    }
+
+    u32 profiler_thread_count()
+    {
+        return std::min(profiler_threads.count.load(std::memory_order_relaxed), PROFILER_MAX_THREADS);
+    }
+
+    void profiler_collect(Array<ProfileZone>& zones, u64 from_ns, u64 to_ns)
+    {
+        for (u32 i = 0; i < profiler_thread_count(); ++i)
+        {
+            const ProfilerThread* thread = profiler_threads.threads[i].load(std::memory_order_acquire);
+
+            if (!thread)
+            {
+                continue;
+            }
+
+            const u64 head  = thread->head.load(std::memory_order_acquire);
+            const u64 first = head > PROFILER_ZONES_PER_THREAD ? head - PROFILER_ZONES_PER_THREAD : 0;
+            const u64 begin = zones.size();
+
+            static thread_local Array<u64> copied;
+            copied.clear();
+
+            for (u64 z = first; z < head; ++z)
+            {
+                const ProfileZone& zone = thread->zones[z % PROFILER_ZONES_PER_THREAD];
+
+                if (zone.start_ns < to_ns && zone.end_ns > from_ns)
+                {
+                    zones.push_back(zone);
+                    copied.push_back(z);
+                }
+            }
+
+            // The writer could have lapped the oldest slots while they were being copied, those are dropped. The
+            // slot of new_head - PROFILER_ZONES_PER_THREAD is the one the writer may be filling right now.
+            const u64 new_head = thread->head.load(std::memory_order_acquire);
+            const u64 safe     = new_head >= PROFILER_ZONES_PER_THREAD ? new_head - PROFILER_ZONES_PER_THREAD + 1 : 0;
+            const u64 lapped   = std::lower_bound(copied.begin(), copied.end(), safe) - copied.begin();
+            zones.erase(zones.begin() + begin, zones.begin() + begin + lapped);
+        }
+    }
+
+    static void write_json_string(StringStream& stream, const char* text)
+    {
+        stream << '"';
+
+        for (const char* c = text; *c; ++c)
+        {
+            if (*c == '"' || *c == '\\')
+            {
+                stream << '\\';
+            }
+
+            stream << *c;
+        }
+
+        stream << '"';
+    }
+
+    String profiler_to_chrome_trace(u64 from_ns, u64 to_ns)
+    {
+        Array<ProfileZone> zones;
+        profiler_collect(zones, from_ns, to_ns);
+
+        StringStream stream;
+        stream << std::fixed << std::setprecision(3);
+        stream << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+
+        for (u32 i = 0; i < profiler_thread_count(); ++i)
+        {
+            stream << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << i << ", \"args\": {\"name\": ";
+            write_json_string(stream, profiler_thread_name(i));
+            stream << "}},\n";
+        }
+
+        for (u32 i = 0; i < zones.size(); ++i)
+        {
+            const ProfileZone& zone = zones[i];
+            stream << "{\"name\": ";
+            write_json_string(stream, zone.name);
+            stream << ", \"ph\": \"X\", \"pid\": 0, \"tid\": " << zone.thread
+                   << ", \"ts\": "  << zone.start_ns / 1000.0
+                   << ", \"dur\": " << (zone.end_ns - zone.start_ns) / 1000.0;
+
+            if (zone.detail || zone.address)
+            {
+                stream << ", \"args\": {\"detail\": ";
+
+                if (zone.detail)
+                {
+                    write_json_string(stream, zone.detail);
+                }
+                else
+                {
+                    stream << "\"" << zone.address << "\"";
+                }
+
+                stream << "}";
+            }
+
+            stream << (i + 1 < zones.size() ? "},\n" : "}\n");
+        }
+
+        stream << "]}\n";
+        return stream.str();
+    }
+
+    bool profiler_export_chrome_trace(const String& path)
+    {
+        std::ofstream file(path);
+
+        if (!file)
+        {
+            NIT_CHECK_MSG(false, "Could not open %s!", path.c_str());
+            return false;
+        }
+
+        file << profiler_to_chrome_trace();
+        return (bool) file;
+    }
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,113 @@
+#pragma once
+
+// Scoped CPU zones, compiled out unless the build defines NIT_PROFILER_ENABLED (debug and release builds do):
+//
+//     NIT_PROFILE_SCOPE("Physics Step");          // String literal
+//     NIT_PROFILE_FUNCTION();
+//     NIT_PROFILE_SCOPE_DETAIL("Asset Load", name); // name is a String, only copied while recording
+//     NIT_PROFILE_SCOPE_ADDRESS("Listener", fn);    // Function address, shown as detail
+//
+// Each thread writes its finished zones to its own ring buffer without locks, the oldest ones get overwritten.
+// Zones with a null name are skipped, which lets call sites decide at runtime whether to profile.
+#ifdef NIT_PROFILER_ENABLED
+
+#define NIT_PROFILE_CONCAT_INNER(_A, _B) _A##_B
+#define NIT_PROFILE_CONCAT(_A, _B) NIT_PROFILE_CONCAT_INNER(_A, _B)
+
+#define NIT_PROFILE_SCOPE(_NAME) \
+nit::ProfileScope NIT_PROFILE_CONCAT(profile_scope_, __COUNTER__)(_NAME)
+
+#define NIT_PROFILE_SCOPE_DETAIL(_NAME, _DETAIL) \
+nit::ProfileScope NIT_PROFILE_CONCAT(profile_scope_, __COUNTER__)(_NAME, _DETAIL)
+
+#define NIT_PROFILE_SCOPE_ADDRESS(_NAME, _ADDRESS) \
+nit::ProfileScope NIT_PROFILE_CONCAT(profile_scope_, __COUNTER__)(_NAME, reinterpret_cast<const void*>(_ADDRESS))
+
+#define NIT_PROFILE_FUNCTION() NIT_PROFILE_SCOPE(__FUNCTION__)
+#define NIT_PROFILE_FRAME() nit::profiler_frame()
+#define NIT_PROFILE_THREAD(_NAME) nit::profiler_set_thread_name(_NAME)
+
+#else
+
+#define NIT_PROFILE_SCOPE(_NAME)
+#define NIT_PROFILE_SCOPE_DETAIL(_NAME, _DETAIL)
+#define NIT_PROFILE_SCOPE_ADDRESS(_NAME, _ADDRESS)
+#define NIT_PROFILE_FUNCTION()
+#define NIT_PROFILE_FRAME()
+#define NIT_PROFILE_THREAD(_NAME)
+
+#endif
+
+#ifdef NIT_PROFILER_ENABLED
+namespace nit
+{
+    constexpr u32 PROFILER_MAX_THREADS      = 64;
+    constexpr u32 PROFILER_ZONES_PER_THREAD = 16 * 1024;
+    constexpr u32 PROFILER_FRAME_HISTORY    = 256;
+
+    struct ProfileZone
+    {
+        const char* name     = nullptr;
+        const char* detail   = nullptr; // Interned, see profiler_intern
+        const void* address  = nullptr;
+        u64         start_ns = 0;
+        u64         end_ns   = 0;
+        u32         depth    = 0;       // Open zones of the thread when this one started
+        u32         thread   = 0;
+    };
+
+    struct ProfilerThread;
+
+    struct ProfileScope
+    {
+        ProfileZone     zone;
+        ProfilerThread* thread = nullptr; // Set while the zone is being recorded
+
+        explicit ProfileScope(const char* name, const void* address = nullptr)
+        {
+            if (name)
+            {
+                begin(name, nullptr, address);
+            }
+        }
+
+        ProfileScope(const char* name, const String& detail);
+
+        ~ProfileScope()
+        {
+            if (thread)
+            {
+                end();
+            }
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+        void begin(const char* name, const char* detail, const void* address);
+        void end();
+    };
+
+    u64         profiler_now_ns();
+    void        profiler_set_recording(bool recording);
+    bool        profiler_recording();
+
+    // Marks the start of a frame, called by the engine loop
+    void        profiler_frame();
+    bool        profiler_last_frame(u64& start_ns, u64& end_ns);
+
+    // Returns a pointer that stays valid until the program ends, meant for names built at runtime
+    const char* profiler_intern(const String& name);
+    void        profiler_set_thread_name(const char* name);
+    void        profiler_set_thread_name(const String& name);
+    const char* profiler_thread_name(u32 thread);
+    u32         profiler_thread_count();
+
+    // Appends the zones that overlap [from_ns, to_ns) from every thread, they can be collected while recording
+    void        profiler_collect(Array<ProfileZone>& zones, u64 from_ns = 0, u64 to_ns = std::numeric_limits<u64>::max());
+
+    // Chrome trace event format, it can be opened in chrome://tracing or ui.perfetto.dev
+    String      profiler_to_chrome_trace(u64 from_ns = 0, u64 to_ns = std::numeric_limits<u64>::max());
+    bool        profiler_export_chrome_trace(const String& path);
+}
+#endif
\ No newline at end of file
@@ -2,6 +2,20 @@
 
 namespace nit
 {
+    static u32& sparse_slot(SparseSet* sparse_set, u32 element)
+    {
+        element = sparse_key(element);
+        u32*& page = sparse_set->pages[element / SparseSet::PAGE_SIZE];
+        
+        if (!page)
+        {
+            page = static_cast<u32*>(memory_alloc(sparse_set->tag, sizeof(u32) * SparseSet::PAGE_SIZE));
+            memset(page, SparseSet::INVALID, sizeof(u32) * SparseSet::PAGE_SIZE);
+        }
+        
+        return page[element % SparseSet::PAGE_SIZE];
+    }
+    
     bool sparse_is_valid(SparseSet* sparse_set)
     {
         return sparse_set && sparse_set->max != 0;
@@ -31,33 +45,49 @@ namespace nit
 
     void sparse_load(SparseSet* sparse_set, u32 max)
     {
-        if (!sparse_set || max == U32_MAX)
+        if (!sparse_set || max == 0 || max > SparseSet::KEY_MASK + 1)
         {
             NIT_DEBUGBREAK();
             return;
         }
 
-        sparse_set->max = max;
-        sparse_set->sparse = new u32[max];
-        sparse_set->dense  = new u32[max];
-        memset(sparse_set->sparse, SparseSet::INVALID, sizeof(u32) * max);
+        sparse_set->max        = max;
+        sparse_set->page_count = sparse_page_count(max);
+        sparse_set->pages      = memory_new_array<u32*>(sparse_set->tag, sparse_set->page_count);
+        sparse_set->count      = 0;
+        sparse_set->capacity   = std::min(max, SparseSet::MIN_CAPACITY);
+        sparse_set->dense      = static_cast<u32*>(memory_alloc(sparse_set->tag, sizeof(u32) * sparse_set->capacity));
     }
     
     u32 sparse_insert(SparseSet* sparse_set, u32 element)
     {
-        if (!sparse_is_valid(sparse_set) || element == SparseSet::INVALID || sparse_test(sparse_set, element))
+        if (!sparse_is_valid(sparse_set) || element == SparseSet::INVALID)
         {
             NIT_DEBUGBREAK();
             return SparseSet::INVALID;
         }
         
-        if (sparse_is_full(sparse_set))
+        const u32 key = sparse_key(element);
+        
+        if (key >= sparse_set->max)
         {
-            sparse_resize(sparse_set, sparse_set->max * 2);
+            sparse_resize(sparse_set, std::min(std::max(key + 1, sparse_set->max * 2), SparseSet::KEY_MASK + 1));
+        }
+        
+        if (sparse_slot(sparse_set, key) != SparseSet::INVALID)
+        {
+            // Either the element is already there or a stale one with the same key was never removed
+            NIT_DEBUGBREAK();
+            return SparseSet::INVALID;
+        }
+        
+        if (sparse_set->count == sparse_set->capacity)
+        {
+            sparse_reserve(sparse_set, sparse_next_capacity(sparse_set));
         }
         
         u32 next_slot = sparse_set->count;
-        sparse_set->sparse[element] = next_slot;
+        sparse_slot(sparse_set, element) = next_slot;
         sparse_set->dense[next_slot] = element;
         ++sparse_set->count;
         return next_slot;
@@ -71,25 +101,18 @@ namespace nit
             return false;
         }
         
-        return element < sparse_set->max && sparse_set->sparse[element] != SparseSet::INVALID;
+        return sparse_get(*sparse_set, element) != SparseSet::INVALID;
     }
 
     u32 sparse_search(SparseSet* sparse_set, u32 element)
     {
-        if (!sparse_is_valid(sparse_set) || element >= sparse_set->max)
+        if (!sparse_is_valid(sparse_set) || sparse_key(element) >= sparse_set->max)
         {
             NIT_DEBUGBREAK();
             return SparseSet::INVALID;
         }
 
-        u32 dense_index = sparse_set->sparse[element];
-        
-        if (dense_index == SparseSet::INVALID)
-        {
-            return SparseSet::INVALID;
-        }
-        
-        return dense_index;
+        return sparse_get(*sparse_set, element);
     }
     
     SparseSetDeletion sparse_remove(SparseSet* sparse_set, u32 element)
@@ -100,10 +123,11 @@ namespace nit
             return { false };
         }
         
-        u32 deleted_slot = sparse_set->sparse[element];
+        u32& element_slot = sparse_slot(sparse_set, element);
+        u32 deleted_slot = element_slot;
         u32 last_slot = sparse_set->count - 1;
         
-        sparse_set->sparse[element] = SparseSet::INVALID;
+        element_slot = SparseSet::INVALID;
         --sparse_set->count;
 
         if (deleted_slot == last_slot)
@@ -114,32 +138,77 @@ namespace nit
         u32 last_element = sparse_set->dense[last_slot];
         sparse_set->dense[deleted_slot] = last_element;
         
-        sparse_set->sparse[last_element] = deleted_slot;
+        sparse_slot(sparse_set, last_element) = deleted_slot;
         return { true, deleted_slot, last_slot };
     }
 
     void sparse_resize(SparseSet* sparse_set, u32 new_max)
     {
-        if (!sparse_is_valid(sparse_set) || new_max > sparse_set->max)
+        if (!sparse_is_valid(sparse_set) || new_max <= sparse_set->max || new_max > SparseSet::KEY_MASK + 1)
         {
             NIT_DEBUGBREAK();
             return;
         }
         
-        u32* new_sparse = new u32[new_max];
-        u32* new_dense  = new u32[new_max];
-    
-        std::copy_n(sparse_set->sparse, sparse_set->max, new_sparse);
-        memset(new_sparse + sparse_set->max, SparseSet::INVALID, (new_max - sparse_set->max) * sizeof(u32));
+        const u32 new_page_count = sparse_page_count(new_max);
         
-        std::copy_n(sparse_set->dense, sparse_set->max, new_dense);
-    
-        delete[] sparse_set->sparse;
-        delete[] sparse_set->dense;
-    
-        sparse_set->sparse = new_sparse;
-        sparse_set->dense  = new_dense;
-        sparse_set->max    = new_max;
+        if (new_page_count > sparse_set->page_count)
+        {
+            u32** new_pages = memory_new_array<u32*>(sparse_set->tag, new_page_count);
+            std::copy_n(sparse_set->pages, sparse_set->page_count, new_pages);
+            memory_delete_array(sparse_set->pages);
+            sparse_set->pages      = new_pages;
+            sparse_set->page_count = new_page_count;
+        }
+        
+        sparse_set->max = new_max;
+    }
+
+    void sparse_reserve(SparseSet* sparse_set, u32 new_capacity)
+    {
+        if (!sparse_is_valid(sparse_set))
+        {
+            NIT_DEBUGBREAK();
+            return;
+        }
+        
+        if (new_capacity <= sparse_set->capacity)
+        {
+            return;
+        }
+        
+        u32* new_dense = static_cast<u32*>(memory_alloc(sparse_set->tag, sizeof(u32) * new_capacity));
+        std::copy_n(sparse_set->dense, sparse_set->count, new_dense);
+        memory_free(sparse_set->dense);
+        
+        sparse_set->dense    = new_dense;
+        sparse_set->capacity = new_capacity;
+    }
+
+    u32 sparse_next_capacity(const SparseSet* sparse_set)
+    {
+        const u32 doubled = std::max(sparse_set->capacity * 2, SparseSet::MIN_CAPACITY);
+        return std::max(std::min(doubled, sparse_set->max), sparse_set->count + 1);
+    }
+
+    u64 sparse_memory(const SparseSet* sparse_set)
+    {
+        if (!sparse_set)
+        {
+            return 0;
+        }
+        
+        u64 bytes = sparse_set->page_count * sizeof(u32*) + sparse_set->capacity * sizeof(u32);
+        
+        for (u32 i = 0; i < sparse_set->page_count; ++i)
+        {
+            if (sparse_set->pages[i])
+            {
+                bytes += SparseSet::PAGE_SIZE * sizeof(u32);
+            }
+        }
+        
+        return bytes;
     }
 
     void sparse_release(SparseSet* sparse_set)
@@ -150,17 +219,22 @@ namespace nit
             return;
         }
         
-        if (sparse_set->sparse)
+        if (sparse_set->pages)
         {
-            delete[] sparse_set->sparse;
-            sparse_set->sparse = nullptr;
+            for (u32 i = 0; i < sparse_set->page_count; ++i)
+            {
+                memory_free(sparse_set->pages[i]);
+            }
+            
+            memory_delete_array(sparse_set->pages);
+            sparse_set->pages = nullptr;
         }
         if (sparse_set->dense)
         {
-            delete[] sparse_set->dense;
+            memory_free(sparse_set->dense);
             sparse_set->dense = nullptr;
         }
         
-        sparse_set->count = sparse_set->max = 0;
+        sparse_set->count = sparse_set->capacity = sparse_set->max = sparse_set->page_count = 0;
     }
 }
\ No newline at end of file
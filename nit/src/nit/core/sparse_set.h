@@ -2,14 +2,27 @@
 
 namespace nit
 {
+    // The sparse array (element -> dense slot) is split in pages of PAGE_SIZE entries (4 KB) that are only allocated
+    // when an element that falls in them is inserted, so a set of a few elements spread over a large range only pays
+    // for the pages it touches. The dense array grows geometrically from MIN_CAPACITY up to max.
+    // Elements are keyed by their low KEY_BITS, the upper bits are a tag (the generation of the entity handles) that
+    // is only kept in the dense array. The set holds one element per key and looking up an element whose tag
+    // does not match the stored one fails, so stale handles never alias the element that reused their key.
     struct SparseSet
     {
-        static constexpr u32 INVALID = U32_MAX;
+        static constexpr u32 INVALID      = U32_MAX;
+        static constexpr u32 PAGE_SIZE    = 1024;
+        static constexpr u32 MIN_CAPACITY = 16;
+        static constexpr u32 KEY_BITS     = 24;
+        static constexpr u32 KEY_MASK     = (1u << KEY_BITS) - 1;
         
-        u32* sparse = nullptr;
-        u32* dense  = nullptr;
-        u32  count  = 0;
-        u32  max    = 0;
+        u32**     pages      = nullptr;
+        u32       page_count = 0;
+        u32*      dense      = nullptr;
+        u32       count      = 0;
+        u32       capacity   = 0; // Allocated dense slots
+        u32       max        = 0; // Element keys have to be lower than max
+        MemoryTag tag        = MemoryTag::General;
     };
     
     struct SparseSetDeletion
@@ -19,14 +32,41 @@ namespace nit
         u32  last_slot    = 0;
     };
 
-    bool              sparse_is_valid (SparseSet* sparse_set);
-    bool              sparse_is_empty (SparseSet* sparse_set);
-    bool              sparse_is_full  (SparseSet* sparse_set);
-    void              sparse_load     (SparseSet* sparse_set, u32 max);
-    u32               sparse_insert   (SparseSet* sparse_set, u32 element);
-    bool              sparse_test     (SparseSet* sparse_set, u32 element);
-    u32               sparse_search   (SparseSet* sparse_set, u32 element);
-    SparseSetDeletion sparse_remove   (SparseSet* sparse_set, u32 element);
-    void              sparse_resize   (SparseSet* sparse_set, u32 new_max);
-    void              sparse_release  (SparseSet* sparse_set);
+    bool              sparse_is_valid     (SparseSet* sparse_set);
+    bool              sparse_is_empty     (SparseSet* sparse_set);
+    bool              sparse_is_full      (SparseSet* sparse_set);
+    void              sparse_load         (SparseSet* sparse_set, u32 max);
+    u32               sparse_insert       (SparseSet* sparse_set, u32 element);
+    bool              sparse_test         (SparseSet* sparse_set, u32 element);
+    u32               sparse_search       (SparseSet* sparse_set, u32 element);
+    SparseSetDeletion sparse_remove       (SparseSet* sparse_set, u32 element);
+    void              sparse_resize       (SparseSet* sparse_set, u32 new_max);
+    void              sparse_reserve      (SparseSet* sparse_set, u32 new_capacity);
+    u32               sparse_next_capacity(const SparseSet* sparse_set);
+    u64               sparse_memory       (const SparseSet* sparse_set);
+    void              sparse_release      (SparseSet* sparse_set);
+
+    inline u32 sparse_page_count(u32 max) { return (max + SparseSet::PAGE_SIZE - 1) / SparseSet::PAGE_SIZE; }
+    inline u32 sparse_key(u32 element)    { return element & SparseSet::KEY_MASK; }
+    
+    // Unchecked lookup for hot loops, returns the dense slot of the element or INVALID
+    inline u32 sparse_get(const SparseSet& sparse_set, u32 element)
+    {
+        const u32 key = sparse_key(element);
+        
+        if (key >= sparse_set.max)
+        {
+            return SparseSet::INVALID;
+        }
+        
+        const u32* page = sparse_set.pages[key / SparseSet::PAGE_SIZE];
+        const u32 slot  = page ? page[key % SparseSet::PAGE_SIZE] : SparseSet::INVALID;
+        return slot != SparseSet::INVALID && sparse_set.dense[slot] == element ? slot : SparseSet::INVALID;
+    }
+
+    // Range-for support, iterates the dense elements
+    inline u32*       begin(SparseSet& sparse_set)       { return sparse_set.dense; }
+    inline u32*       end  (SparseSet& sparse_set)       { return sparse_set.dense + sparse_set.count; }
+    inline const u32* begin(const SparseSet& sparse_set) { return sparse_set.dense; }
+    inline const u32* end  (const SparseSet& sparse_set) { return sparse_set.dense + sparse_set.count; }
 }
\ No newline at end of file
@@ -41,6 +41,13 @@ namespace nit
     void set_array_raw_data(const Type* type, void* array, u32 index, void* data)
     {
         NIT_CHECK(type && type->fn_set_data && array);
+
+        if (data && type->trivially_copyable)
+        {
+            memcpy(static_cast<u8*>(array) + index * type->size, data, type->size);
+            return;
+        }
+
         type->fn_set_data(array, index, data);
     }
 
@@ -50,15 +57,52 @@ namespace nit
         return type->fn_get_data(array, index);
     }
 
-    void resize_array(const Type* type, void* array, u32 max, u32 new_max)
+    void move_array_raw_data(const Type* type, void* dst_array, u32 dst_index, void* src_array, u32 src_index)
     {
-        if (!type || !type->fn_resize_data || !array || new_max <= max)
+        NIT_CHECK(type && type->fn_move_data && dst_array && src_array);
+        
+        if (type->trivially_copyable)
         {
-            NIT_DEBUGBREAK();
+            memcpy(static_cast<u8*>(dst_array) + dst_index * type->size, static_cast<u8*>(src_array) + src_index * type->size, type->size);
             return;
         }
         
-        type->fn_resize_data(array, max, new_max);
+        type->fn_move_data(dst_array, dst_index, src_array, src_index);
+    }
+
+    void relocate_array(const Type* type, void* dst_array, void* src_array, u32 count)
+    {
+        NIT_CHECK(type && type->fn_relocate_data && dst_array && src_array);
+        type->fn_relocate_data(dst_array, src_array, count);
+    }
+
+    void* resize_array(const Type* type, void* array, u32 max, u32 new_max, MemoryTag tag)
+    {
+        if (!type || !array || new_max <= max)
+        {
+            NIT_DEBUGBREAK();
+            return array;
+        }
+        
+        void* new_elements = new_array(type, new_max, tag);
+        relocate_array(type, new_elements, array, max);
+        delete_array(type, array);
+        return new_elements;
+    }
+
+    void* new_array(const Type* type, u32 max, MemoryTag tag)
+    {
+        NIT_CHECK(type && type->fn_new_data);
+        return type->fn_new_data(max, tag);
+    }
+
+    void delete_array(const Type* type, void* array)
+    {
+        NIT_CHECK(type && type->fn_delete_data);
+        if (array)
+        {
+            type->fn_delete_data(array);
+        }
     }
 
     void load(const Type* type, void* data)
@@ -8,7 +8,10 @@ namespace nit
     {
         using FnSetData           = void  (*) (void*, u32, void*);
         using FnGetData           = void* (*) (void*, u32);
-        using FnResizeData        = void* (*) (void*, u32, u32);
+        using FnMoveData          = void  (*) (void*, u32, void*, u32);
+        using FnRelocateData      = void  (*) (void*, void*, u32);
+        using FnNewData           = void* (*) (u32, MemoryTag);
+        using FnDeleteData        = void  (*) (void*);
         using FnInvokeLoad        = Function<void(void*)>;
         using FnInvokeFree        = Function<void(void*)>;
         using FnInvokeSerialize   = Function<void(void*, YAML::Emitter& emitter)>;
@@ -20,9 +23,14 @@ namespace nit
         
         String              name;
         u64                 hash                  = 0;
+        u32                 size                  = 0;
+        bool                trivially_copyable    = false; // Copies, moves and relocations are a plain memcpy
         FnSetData           fn_set_data           = nullptr;
         FnGetData           fn_get_data           = nullptr;
-        FnResizeData        fn_resize_data        = nullptr;
+        FnMoveData          fn_move_data          = nullptr;
+        FnRelocateData      fn_relocate_data      = nullptr;
+        FnNewData           fn_new_data           = nullptr;
+        FnDeleteData        fn_delete_data        = nullptr;
         FnInvokeLoad        fn_invoke_load        = nullptr;
         FnInvokeFree        fn_invoke_free        = nullptr;
         FnInvokeSerialize   fn_invoke_serialize   = nullptr;
@@ -107,7 +115,11 @@ namespace nit
 
     void  set_array_raw_data(const Type* type, void* array, u32 index, void* data);
     void* get_array_raw_data(const Type* type, void* array, u32 index);
-    void  resize_array(const Type* type, void* array, u32 max, u32 new_max);
+    void  move_array_raw_data(const Type* type, void* dst_array, u32 dst_index, void* src_array, u32 src_index);
+    void  relocate_array(const Type* type, void* dst_array, void* src_array, u32 count);
+    void* resize_array(const Type* type, void* array, u32 max, u32 new_max, MemoryTag tag = MemoryTag::General);
+    void* new_array(const Type* type, u32 max, MemoryTag tag = MemoryTag::General);
+    void  delete_array(const Type* type, void* array);
     void  load(const Type* type, void* data);
     void  type_release(const Type* type, void* data);
     void  serialize(const Type* type, void* data, YAML::Emitter& emitter);
@@ -82,6 +82,8 @@ namespace nit
     void init_type(Type& type, const TypeArgs<T>& args)
     {
         type.hash = get_type_hash<T>();
+        type.size = sizeof(T);
+        type.trivially_copyable = std::is_trivially_copyable_v<T>;
         
         static const String STRUCT_TEXT = "struct "; 
         static const String CLASS_TEXT  = "class "; 
@@ -105,12 +107,28 @@ namespace nit
             return data;
         };
 
-        type.fn_resize_data = [](void* elements, u32 max, u32 new_max) -> void* {
-            T* casted_elements = static_cast<T*>(elements);
-            T* new_elements = new T[new_max];
-            std::copy_n(casted_elements, max, new_elements);
-            delete [] new_elements;
-            return new_elements;
+        type.fn_move_data = [](void* dst_elements, u32 dst_index, void* src_elements, u32 src_index) {
+            static_cast<T*>(dst_elements)[dst_index] = std::move(static_cast<T*>(src_elements)[src_index]);
+        };
+
+        type.fn_relocate_data = [](void* dst_elements, void* src_elements, u32 count) {
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                memcpy(dst_elements, src_elements, sizeof(T) * count);
+            }
+            else
+            {
+                T* casted_elements = static_cast<T*>(src_elements);
+                std::move(casted_elements, casted_elements + count, static_cast<T*>(dst_elements));
+            }
+        };
+
+        type.fn_new_data = [](u32 max, MemoryTag tag) -> void* {
+            return memory_new_array<T>(tag, max);
+        };
+
+        type.fn_delete_data = [](void* elements) {
+            memory_delete_array(static_cast<T*>(elements));
         };
         
         if (auto fn_serialize = args.fn_serialize)
@@ -106,6 +106,7 @@ namespace nit
             pool_free(&editor->asset_nodes);
         }
         
+        editor->asset_nodes.tag = MemoryTag::Editor;
         pool_load<AssetNode>(&editor->asset_nodes, 300, true);
 
         pool_insert_data(&editor->asset_nodes, editor->root_node, AssetNode{ .is_dir = true, .path = "" });
@@ -175,7 +176,8 @@ namespace nit
         String name = entity_get_name(entity);
         
         ImGuiTreeNodeFlags flags = entity_valid(entity) && selected_entity == entity ? ImGuiTreeNodeFlags_Selected: 0;
-        Array<EntityID> children;
+        ArenaScope temp_scope;
+        ArenaArray<EntityID> children(temp_scope.arena);
         
         entity_get_children(entity, children);
         
@@ -203,7 +205,7 @@ namespace nit
             if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_None))
             {
                 ImGui::SetDragDropPayload("ENTITY_DRAG", &entity, sizeof(EntityID));
-                ImGui::Text("Drag Entity %d", entity);
+                ImGui::Text("Drag Entity %u", entity_index(entity));
                 ImGui::EndDragDropSource();
             }
 
@@ -277,6 +279,109 @@ namespace nit
             ImGui::TreePop();
         }
     }
+
+#ifdef NIT_PROFILER_ENABLED
+    // Flame graph of the last recorded frame, one lane per thread with the zones stacked by depth
+    static void draw_profiler()
+    {
+        ImGui::Begin("Profiler", &editor->show_profiler);
+
+        bool recording = profiler_recording();
+
+        if (ImGui::Checkbox("Record", &recording))
+        {
+            profiler_set_recording(recording);
+        }
+
+        ImGui::SameLine();
+
+        if (ImGui::Button("Export Chrome Trace"))
+        {
+            profiler_export_chrome_trace("profile.json");
+        }
+
+        u64 frame_start, frame_end;
+
+        if (!profiler_last_frame(frame_start, frame_end) || frame_end <= frame_start)
+        {
+            ImGui::End();
+            return;
+        }
+
+        static Array<ProfileZone> zones;
+        zones.clear();
+        profiler_collect(zones, frame_start, frame_end);
+        ImGui::Text("Frame %.3f ms, %u zones", (frame_end - frame_start) / 1e6, (u32) zones.size());
+
+        const u32 thread_count = profiler_thread_count();
+        u32 lane_depths[PROFILER_MAX_THREADS] = {};
+
+        for (const ProfileZone& zone : zones)
+        {
+            lane_depths[zone.thread] = std::max(lane_depths[zone.thread], zone.depth + 1);
+        }
+
+        ImDrawList* draw_list  = ImGui::GetWindowDrawList();
+        const ImVec2 origin    = ImGui::GetCursorScreenPos();
+        const f32 width        = std::max(ImGui::GetContentRegionAvail().x, 1.f);
+        const f32 row_height   = ImGui::GetTextLineHeightWithSpacing();
+        const f64 ns_to_pixels = width / (f64) (frame_end - frame_start);
+
+        f32 lane_y[PROFILER_MAX_THREADS] = {};
+        f32 height = 0;
+
+        for (u32 thread = 0; thread < thread_count; ++thread)
+        {
+            if (lane_depths[thread] == 0)
+            {
+                continue;
+            }
+
+            lane_y[thread] = height;
+            draw_list->AddText({ origin.x, origin.y + height }, IM_COL32_WHITE, profiler_thread_name(thread));
+            height += row_height * (lane_depths[thread] + 1);
+        }
+
+        for (const ProfileZone& zone : zones)
+        {
+            const f32 x0 = origin.x + (f32) ((std::max(zone.start_ns, frame_start) - frame_start) * ns_to_pixels);
+            const f32 x1 = std::max(origin.x + (f32) ((std::min(zone.end_ns, frame_end) - frame_start) * ns_to_pixels), x0 + 1.f);
+            const f32 y0 = origin.y + lane_y[zone.thread] + row_height * (zone.depth + 1);
+            const ImVec2 min = { x0, y0 };
+            const ImVec2 max = { x1, y0 + row_height - 1.f };
+
+            const u64 hash = std::hash<std::string_view>{}(zone.name);
+            draw_list->AddRectFilled(min, max, ImColor::HSV((hash % 360) / 360.f, 0.5f, 0.7f));
+
+            if (x1 - x0 > 20.f)
+            {
+                draw_list->PushClipRect(min, max, true);
+                draw_list->AddText({ x0 + 2.f, y0 }, IM_COL32_WHITE, zone.name);
+                draw_list->PopClipRect();
+            }
+
+            if (ImGui::IsMouseHoveringRect(min, max))
+            {
+                ImGui::BeginTooltip();
+                ImGui::Text("%s %.3f ms", zone.name, (zone.end_ns - zone.start_ns) / 1e6);
+
+                if (zone.detail)
+                {
+                    ImGui::Text("%s", zone.detail);
+                }
+                else if (zone.address)
+                {
+                    ImGui::Text("%p", zone.address);
+                }
+
+                ImGui::EndTooltip();
+            }
+        }
+
+        ImGui::Dummy({ width, height });
+        ImGui::End();
+    }
+#endif
     
     void editor_begin()
     {
@@ -367,6 +472,9 @@ namespace nit
                 ImGui::MenuItem("Properties", nullptr, &editor->show_properties);
                 ImGui::MenuItem("Assets", nullptr, &editor->show_assets);
                 ImGui::MenuItem("Stats", nullptr, &editor->show_stats);
+#ifdef NIT_PROFILER_ENABLED
+                ImGui::MenuItem("Profiler", nullptr, &editor->show_profiler);
+#endif
                 ImGui::EndMenu();
             }
             ImGui::EndMenuBar();
@@ -513,7 +621,7 @@ namespace nit
 
                 auto& camera_group = entity_get_group<Camera, Transform>();
 
-                if (!camera_group.entities.empty())
+                if (camera_group.entities.count != 0)
                 {
                     EntityID camera_entity = get_main_camera();
 
@@ -523,7 +631,8 @@ namespace nit
                     if (entity_valid(selected_entity) && editor->selection == Editor::Selection::Entity && entity_valid(camera_entity) && entity_has<Transform>(selected_entity))
                     {
                         auto& camera_data      = entity_get<Camera>(camera_entity);
-                        camera_data.aspect = engine_window_size().x / engine_window_size().y;
+                        const Vector2 window_size = engine_window_size();
+                        camera_data.aspect = window_size.x / window_size.y;
                         
                         auto& camera_transform = entity_get<Transform>(camera_entity);
                         
@@ -768,7 +877,7 @@ namespace nit
                 }
                 
                 editor_draw_text("UUID", "%llu", (u64) entity_get_uuid(selected_entity));
-                editor_draw_text("Entity ID", "%u", selected_entity);
+                editor_draw_text("Entity ID", "%u (generation %u)", entity_index(selected_entity), entity_generation(selected_entity));
 
                 ImGui::Separator();
                 ImGui::Spacing();
@@ -812,7 +921,7 @@ namespace nit
 
                         if (pool->data_pool.type->fn_invoke_draw_editor)
                         {
-                            void* data = pool_get_raw_data(&pool->data_pool, selected_entity);
+                            void* data = delegate_invoke(pool->fn_get_from_entity, selected_entity);
                             NIT_CHECK(data);
                             type_draw_editor(component_type, data);
                         }
@@ -1030,15 +1139,42 @@ namespace nit
             ImGui::SetNextWindowBgAlpha(0.35f); // Transparent background
 
             ImGui::Begin("Stats", &editor->show_stats, window_flags);
-            String stats_text;
-            stats_text.append("\nTime: "     + std::to_string(engine_get_instance()->seconds));
-            stats_text.append("\nFrames: "   + std::to_string(engine_get_instance()->frame_count));
-            stats_text.append("\nFPS: "      + std::to_string(1.f / delta_seconds()));
-            stats_text.append("\nEntities: " + std::to_string(engine_get_instance()->entity_registry.entity_count));
-            stats_text.append("\nDelta: "    + std::to_string(delta_seconds()));
-            ImGui::Text(stats_text.c_str());
+            ImGui::Text("\nTime: %f\nFrames: %u\nFPS: %f\nEntities: %u\nDelta: %f\nAllocations: %llu"
+                , engine_get_instance()->seconds
+                , engine_get_instance()->frame_count
+                , 1.f / delta_seconds()
+                , engine_get_instance()->entity_registry.entity_count
+                , delta_seconds()
+                , engine_get_instance()->frame_heap_allocations);
+
+            if (ImGui::CollapsingHeader("Memory"))
+            {
+                const MemoryReport report = memory_report();
+
+                for (u32 i = 0; i < MEMORY_TAG_COUNT; ++i)
+                {
+                    const MemoryStats& stats = report.tags[i];
+                    ImGui::Text("%-8s %10.1f KB (peak %.1f KB, %llu allocs)", memory_tag_name((MemoryTag) i)
+                        , stats.bytes / 1024.0, stats.peak_bytes / 1024.0, stats.allocations);
+                }
+
+                ImGui::Text("%-8s %10.1f KB (peak %.1f KB, %llu allocs)", "Total"
+                    , report.total.bytes / 1024.0, report.total.peak_bytes / 1024.0, report.total.allocations);
+
+                if (ImGui::Button("Dump JSON"))
+                {
+                    memory_report_dump("memory_report.json");
+                }
+            }
             ImGui::End();
         }
+
+#ifdef NIT_PROFILER_ENABLED
+        if (editor->show_profiler)
+        {
+            draw_profiler();
+        }
+#endif
     }
 
     void editor_end()
@@ -46,6 +46,7 @@ namespace nit
         bool          show_properties      = true;
         bool          show_assets          = true;
         bool          show_stats           = false;
+        bool          show_profiler        = false;
         bool          is_using_gizmo       = false;
         bool          is_paused            = false;
         bool          is_stopped           = true;
@@ -0,0 +1,234 @@
+#include "archetype.h"
+
+namespace nit
+{
+    static ArchetypeRecord& get_record(ArchetypeStorage* storage, EntityID entity)
+    {
+        NIT_CHECK_MSG(storage && entity_index(entity) < storage->max_records, "Entity out of range!");
+        return storage->records[entity_index(entity)];
+    }
+
+    static void* get_column_data(Archetype* archetype, u32 column, u32 row)
+    {
+        ArchetypeChunk& chunk = archetype->chunks[row / archetype->chunk_capacity];
+        return get_array_raw_data(archetype->types[column], chunk.columns[column], row % archetype->chunk_capacity);
+    }
+
+    static void set_column_data(Archetype* archetype, u32 column, u32 row, void* data)
+    {
+        ArchetypeChunk& chunk = archetype->chunks[row / archetype->chunk_capacity];
+        set_array_raw_data(archetype->types[column], chunk.columns[column], row % archetype->chunk_capacity, data);
+    }
+
+    static void move_column_data(Archetype* dst_archetype, u32 dst_column, u32 dst_row, Archetype* src_archetype, u32 src_column, u32 src_row)
+    {
+        ArchetypeChunk& dst_chunk = dst_archetype->chunks[dst_row / dst_archetype->chunk_capacity];
+        ArchetypeChunk& src_chunk = src_archetype->chunks[src_row / src_archetype->chunk_capacity];
+        move_array_raw_data(dst_archetype->types[dst_column], dst_chunk.columns[dst_column], dst_row % dst_archetype->chunk_capacity
+            , src_chunk.columns[src_column], src_row % src_archetype->chunk_capacity);
+    }
+
+    static EntityID& get_row_entity(Archetype* archetype, u32 row)
+    {
+        return archetype->chunks[row / archetype->chunk_capacity].entities[row % archetype->chunk_capacity];
+    }
+
+    static u32 archetype_push_row(Archetype* archetype, EntityID entity)
+    {
+        const u32 row = archetype->count;
+
+        if (row == archetype->chunks.size() * archetype->chunk_capacity)
+        {
+            ArchetypeChunk chunk;
+            chunk.columns  = memory_new_array<void*>(MemoryTag::Entity, archetype->types.size());
+            chunk.entities = memory_new_array<EntityID>(MemoryTag::Entity, archetype->chunk_capacity);
+
+            for (u32 column = 0; column < archetype->types.size(); ++column)
+            {
+                chunk.columns[column] = new_array(archetype->types[column], archetype->chunk_capacity, MemoryTag::Entity);
+            }
+
+            archetype->chunks.push_back(chunk);
+        }
+
+        ++archetype->count;
+        get_row_entity(archetype, row) = entity;
+        return row;
+    }
+
+    static void archetype_swap_remove_row(ArchetypeStorage* storage, Archetype* archetype, u32 row)
+    {
+        NIT_CHECK(row < archetype->count);
+        const u32 last_row = archetype->count - 1;
+
+        if (row != last_row)
+        {
+            for (u32 column = 0; column < archetype->types.size(); ++column)
+            {
+                move_column_data(archetype, column, row, archetype, column, last_row);
+            }
+
+            EntityID moved_entity = get_row_entity(archetype, last_row);
+            get_row_entity(archetype, row) = moved_entity;
+            get_record(storage, moved_entity).row = row;
+        }
+
+        // Reset the vacated slot so it does not keep resources alive until it gets reused
+        for (u32 column = 0; column < archetype->types.size(); ++column)
+        {
+            if (!archetype->types[column]->trivially_copyable)
+            {
+                set_column_data(archetype, column, last_row, nullptr);
+            }
+        }
+
+        --archetype->count;
+    }
+
+    void archetype_storage_load(ArchetypeStorage* storage, u32 max_entities)
+    {
+        NIT_CHECK(storage && !storage->records);
+        storage->records     = memory_new_array<ArchetypeRecord>(MemoryTag::Entity, max_entities);
+        storage->max_records = max_entities;
+    }
+
+    void archetype_storage_free(ArchetypeStorage* storage)
+    {
+        NIT_CHECK(storage);
+
+        for (Archetype* archetype : storage->archetypes)
+        {
+            for (ArchetypeChunk& chunk : archetype->chunks)
+            {
+                for (u32 column = 0; column < archetype->types.size(); ++column)
+                {
+                    delete_array(archetype->types[column], chunk.columns[column]);
+                }
+
+                memory_delete_array(chunk.columns);
+                memory_delete_array(chunk.entities);
+            }
+
+            delete archetype;
+        }
+
+        storage->archetypes.clear();
+        storage->signature_to_archetype.clear();
+        memory_delete_array(storage->records);
+        storage->records     = nullptr;
+        storage->max_records = 0;
+    }
+
+    u32 archetype_get_or_create(ArchetypeStorage* storage, const EntitySignature& signature)
+    {
+        NIT_CHECK(storage);
+
+        if (auto it = storage->signature_to_archetype.find(signature); it != storage->signature_to_archetype.end())
+        {
+            return it->second;
+        }
+
+        EntityRegistry* entity_registry = entity_registry_get_instance();
+
+        Archetype* archetype = new Archetype();
+        archetype->signature = signature;
+        FillRaw(archetype->columns, NIT_MAX_COMPONENT_TYPES + 1, ARCHETYPE_INVALID);
+
+        u32 row_size = sizeof(EntityID);
+
+        for (u32 type_index = 1; type_index < entity_registry->next_component_type_index; ++type_index)
+        {
+            if (!signature.test(type_index))
+            {
+                continue;
+            }
+
+            Type* type = entity_registry->component_pool[type_index - 1].data_pool.type;
+            archetype->columns[type_index] = (u32) archetype->types.size();
+            archetype->types.push_back(type);
+            archetype->type_indices.push_back(type_index);
+            row_size += type->size;
+        }
+
+        archetype->chunk_capacity = std::max(ARCHETYPE_CHUNK_BYTES / row_size, 1u);
+
+        const u32 archetype_index = (u32) storage->archetypes.size();
+        storage->archetypes.push_back(archetype);
+        storage->signature_to_archetype[signature] = archetype_index;
+        return archetype_index;
+    }
+
+    void archetype_move_entity(ArchetypeStorage* storage, EntityID entity, const EntitySignature& signature)
+    {
+        ArchetypeRecord& record = get_record(storage, entity);
+
+        // Only the validity bit means that the entity has no components, so it does not live in any archetype
+        EntitySignature empty_signature;
+        empty_signature.set(0, true);
+        const u32 target = signature == empty_signature ? ARCHETYPE_INVALID : archetype_get_or_create(storage, signature);
+
+        if (target == record.archetype)
+        {
+            return;
+        }
+
+        Archetype* source = record.archetype != ARCHETYPE_INVALID ? storage->archetypes[record.archetype] : nullptr;
+        u32 target_row = 0;
+
+        if (target != ARCHETYPE_INVALID)
+        {
+            Archetype* destination = storage->archetypes[target];
+            target_row = archetype_push_row(destination, entity);
+
+            if (source)
+            {
+                for (u32 column = 0; column < source->types.size(); ++column)
+                {
+                    if (u32 target_column = destination->columns[source->type_indices[column]]; target_column != ARCHETYPE_INVALID)
+                    {
+                        move_column_data(destination, target_column, target_row, source, column, record.row);
+                    }
+                }
+            }
+        }
+
+        if (source)
+        {
+            archetype_swap_remove_row(storage, source, record.row);
+        }
+
+        record.archetype = target;
+        record.row       = target_row;
+    }
+
+    void archetype_remove_entity(ArchetypeStorage* storage, EntityID entity)
+    {
+        EntitySignature empty_signature;
+        empty_signature.set(0, true);
+        archetype_move_entity(storage, entity, empty_signature);
+    }
+
+    void* archetype_get_raw_data(ArchetypeStorage* storage, EntityID entity, u32 type_index)
+    {
+        const ArchetypeRecord& record = get_record(storage, entity);
+
+        if (record.archetype == ARCHETYPE_INVALID)
+        {
+            return nullptr;
+        }
+
+        Archetype* archetype = storage->archetypes[record.archetype];
+        const u32 column = archetype->columns[type_index];
+        return column != ARCHETYPE_INVALID ? get_column_data(archetype, column, record.row) : nullptr;
+    }
+
+    void archetype_set_raw_data(ArchetypeStorage* storage, EntityID entity, u32 type_index, void* data)
+    {
+        const ArchetypeRecord& record = get_record(storage, entity);
+        NIT_CHECK_MSG(record.archetype != ARCHETYPE_INVALID, "Entity is not stored in any archetype!");
+        Archetype* archetype = storage->archetypes[record.archetype];
+        const u32 column = archetype->columns[type_index];
+        NIT_CHECK_MSG(column != ARCHETYPE_INVALID, "Component is not part of the entity archetype!");
+        set_column_data(archetype, column, record.row, data);
+    }
+}
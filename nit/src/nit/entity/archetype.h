@@ -0,0 +1,102 @@
+#pragma once
+#include "entity.h"
+
+namespace nit
+{
+    inline constexpr u32 ARCHETYPE_CHUNK_BYTES = 16 * 1024;
+    inline constexpr u32 ARCHETYPE_INVALID     = U32_MAX;
+
+    // Each chunk holds one column per component of the archetype plus the owner entities, all of them
+    // chunk_capacity elements long, so rows of the same archetype are contiguous in memory.
+    struct ArchetypeChunk
+    {
+        void**    columns  = nullptr;
+        EntityID* entities = nullptr;
+    };
+
+    struct Archetype
+    {
+        EntitySignature       signature;
+        Array<Type*>          types;
+        Array<u32>            type_indices;
+        u32                   columns[NIT_MAX_COMPONENT_TYPES + 1]; // Component type index -> column, ARCHETYPE_INVALID if missing
+        u32                   chunk_capacity = 0;
+        Array<ArchetypeChunk> chunks;
+        u32                   count          = 0;
+    };
+
+    struct ArchetypeRecord
+    {
+        u32 archetype = ARCHETYPE_INVALID;
+        u32 row       = 0;
+    };
+
+    struct ArchetypeStorage
+    {
+        Array<Archetype*>         archetypes;
+        Map<EntitySignature, u32> signature_to_archetype;
+        ArchetypeRecord*          records     = nullptr;
+        u32                       max_records = 0;
+    };
+
+    void       archetype_storage_load(ArchetypeStorage* storage, u32 max_entities);
+    void       archetype_storage_free(ArchetypeStorage* storage);
+    u32        archetype_get_or_create(ArchetypeStorage* storage, const EntitySignature& signature);
+    void       archetype_move_entity(ArchetypeStorage* storage, EntityID entity, const EntitySignature& signature);
+    void       archetype_remove_entity(ArchetypeStorage* storage, EntityID entity);
+    void*      archetype_get_raw_data(ArchetypeStorage* storage, EntityID entity, u32 type_index);
+    void       archetype_set_raw_data(ArchetypeStorage* storage, EntityID entity, u32 type_index, void* data);
+
+    inline u32 archetype_chunk_count(const Archetype* archetype, u32 chunk_index)
+    {
+        const u32 first_row = chunk_index * archetype->chunk_capacity;
+        return archetype->count > first_row ? std::min(archetype->count - first_row, archetype->chunk_capacity) : 0;
+    }
+
+    inline EntityID archetype_row_entity(const Archetype* archetype, u32 row)
+    {
+        return archetype->chunks[row / archetype->chunk_capacity].entities[row % archetype->chunk_capacity];
+    }
+
+    template<typename T>
+    T& archetype_row_data(const Archetype* archetype, u32 column, u32 row)
+    {
+        return static_cast<T*>(archetype->chunks[row / archetype->chunk_capacity].columns[column])[row % archetype->chunk_capacity];
+    }
+
+    // Visits every entity that has all the components T..., walking the archetype columns chunk by chunk.
+    // Structural changes (entity_add / entity_remove / entity_destroy) are not allowed inside the callback.
+    template<typename... T, typename F>
+    void archetype_for_each(F&& fn)
+    {
+        EntityRegistry* entity_registry = entity_registry_get_instance();
+        NIT_CHECK_MSG(entity_registry->archetype_storage, "Entity registry is not using archetype storage!");
+        const EntitySignature signature = entity_build_signature<T...>();
+
+        for (Archetype* archetype : entity_registry->archetype_storage->archetypes)
+        {
+            if (!entity_signature_contains(archetype->signature, signature))
+            {
+                continue;
+            }
+
+            for (u32 chunk_index = 0; chunk_index < archetype->chunks.size(); ++chunk_index)
+            {
+                const u32 count = archetype_chunk_count(archetype, chunk_index);
+
+                if (count == 0)
+                {
+                    break;
+                }
+
+                const ArchetypeChunk& chunk = archetype->chunks[chunk_index];
+                std::tuple<T*...> columns { static_cast<T*>(chunk.columns[archetype->columns[component_type_index<T>]])... };
+
+                for (u32 i = 0; i < count; ++i)
+                {
+                    fn(chunk.entities[i], std::get<T*>(columns)[i]...);
+                }
+            }
+        }
+    }
+}
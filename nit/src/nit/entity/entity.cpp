@@ -1,4 +1,7 @@
 ﻿#include "entity.h"
+#include "archetype.h"
+#include "entity_commands.h"
+#include "nit/core/job_system.h"
 
 #include "physics/box_collider_2d.h"
 #include "physics/circle_collider.h"
@@ -23,6 +26,30 @@ namespace nit
         return entity_registry;
     }
 
+    void* entity_archetype_get(EntityID entity, u32 type_index)
+    {
+        NIT_CHECK_ENTITY_REGISTRY_CREATED
+        return archetype_get_raw_data(entity_registry->archetype_storage, entity, type_index);
+    }
+
+    void* entity_archetype_insert(EntityID entity, u32 type_index, void* data)
+    {
+        NIT_CHECK_ENTITY_REGISTRY_CREATED
+        EntitySignature signature = entity_registry->signatures[entity_index(entity)];
+        signature.set(type_index, true);
+        archetype_move_entity(entity_registry->archetype_storage, entity, signature);
+        archetype_set_raw_data(entity_registry->archetype_storage, entity, type_index, data);
+        return archetype_get_raw_data(entity_registry->archetype_storage, entity, type_index);
+    }
+
+    void entity_archetype_erase(EntityID entity, u32 type_index)
+    {
+        NIT_CHECK_ENTITY_REGISTRY_CREATED
+        EntitySignature signature = entity_registry->signatures[entity_index(entity)];
+        signature.set(type_index, false);
+        archetype_move_entity(entity_registry->archetype_storage, entity, signature);
+    }
+
     ComponentPool* entity_find_component_pool(const Type* type)
     {
         NIT_CHECK_ENTITY_REGISTRY_CREATED
@@ -57,9 +84,9 @@ namespace nit
                 continue;
             }
             
-            void* component_data = delegate_invoke(pool->fn_get_from_entity, entity);
+            const void* component_data = delegate_invoke(pool->fn_get_const_from_entity, entity);
             
-            delegate_invoke(pool->fn_add_to_entity, cloned_entity, component_data, true);
+            delegate_invoke(pool->fn_add_to_entity, cloned_entity, const_cast<void*>(component_data), true);
             
             //Turbo hack
             if (pool->data_pool.type == type_get<Transform>())
@@ -86,17 +113,16 @@ namespace nit
                 collider.handle = {};
             }
             
-            ComponentAddedArgs args;
-            args.entity = cloned_entity;
-            args.type = pool->data_pool.type;
-            event_broadcast<const ComponentAddedArgs&>(entity_registry_get_instance()->component_added_event, args);
+            component_broadcast_added(pool, cloned_entity);
         }
         
-        Array<EntityID> children; entity_get_children(entity, children);
+        ArenaScope temp_scope;
+        ArenaArray<EntityID> children(temp_scope.arena);
+        entity_get_children(entity, children);
         
         for (EntityID child : children)
         {
-            EntityID cloned_child = entity_clone(child, entity_get<Transform>(child).position);
+            EntityID cloned_child = entity_clone(child, entity_get_const<Transform>(child).position);
             entity_set_parent(cloned_child, cloned_entity);
         }
 
@@ -107,30 +133,154 @@ namespace nit
     EntitySignature entity_get_signature(EntityID entity)
     {
         NIT_CHECK_ENTITY_REGISTRY_CREATED
-        if (entity_valid(entity))
+        if (!entity_valid(entity))
         {
             NIT_CHECK_MSG(false, "Trying to get signature from non existent entity!");
             return {};
         }
 
-        return pool_get_data<EntityData>(&entity_registry->entities, entity)->signature;
+        return entity_registry->signatures[entity_index(entity)];
     }
 
     void entity_registry_init()
     {
         NIT_CHECK_ENTITY_REGISTRY_CREATED
+        NIT_CHECK_MSG(entity_registry->max_entities <= ENTITY_INDEX_MASK, "Max entities out of range!");
 
+        entity_registry->entities.tag = MemoryTag::Entity;
         pool_load<EntityData>(&entity_registry->entities, entity_registry->max_entities);
-        entity_registry->component_pool = new ComponentPool[NIT_MAX_COMPONENT_TYPES];
+        entity_registry->component_pool      = new ComponentPool[NIT_MAX_COMPONENT_TYPES];
+        entity_registry->generations         = memory_new_array<u8>(MemoryTag::Entity, entity_registry->max_entities);
+        entity_registry->signatures          = memory_new_array<EntitySignature>(MemoryTag::Entity, entity_registry->max_entities);
+        entity_registry->parents             = memory_new_array<EntityID>(MemoryTag::Entity, entity_registry->max_entities);
+        entity_registry->enabled_bits        = memory_new_array<u64>(MemoryTag::Entity, entity_bit_words(entity_registry->max_entities));
+        entity_registry->global_enabled_bits = memory_new_array<u64>(MemoryTag::Entity, entity_bit_words(entity_registry->max_entities));
+        std::fill_n(entity_registry->parents, entity_registry->max_entities, NULL_ENTITY);
+        std::fill_n(entity_registry->generations, entity_registry->max_entities, ENTITY_FREE_BIT);
+
+        if (entity_registry->storage == EntityStorage::Archetype)
+        {
+            entity_registry->archetype_storage = new ArchetypeStorage();
+            archetype_storage_load(entity_registry->archetype_storage, entity_registry->max_entities);
+        }
+
+        entity_commands_init();
     }
 
     void entity_registry_finish()
     {
         NIT_CHECK_ENTITY_REGISTRY_CREATED
+        entity_commands_finish();
+
+        memory_delete_array(entity_registry->generations);
+        memory_delete_array(entity_registry->signatures);
+        memory_delete_array(entity_registry->parents);
+        memory_delete_array(entity_registry->enabled_bits);
+        memory_delete_array(entity_registry->global_enabled_bits);
+        entity_registry->generations         = nullptr;
+        entity_registry->signatures          = nullptr;
+        entity_registry->parents             = nullptr;
+        entity_registry->enabled_bits        = nullptr;
+        entity_registry->global_enabled_bits = nullptr;
+
+        for (auto& [signature, group] : entity_registry->entity_groups)
+        {
+            sparse_release(&group.entities);
+        }
+
+        for (u32 i = 0; i < entity_registry->next_component_type_index - 1; ++i)
+        {
+            ComponentPool& component_pool = entity_registry->component_pool[i];
+            
+            for (u32 page = 0; page < sparse_page_count(entity_registry->max_entities); ++page)
+            {
+                memory_delete_array(component_pool.change_ticks[page]);
+            }
+            
+            memory_delete_array(component_pool.change_ticks);
+            component_pool.change_ticks = nullptr;
+            
+            if (!entity_registry->archetype_storage)
+            {
+                pool_free(&component_pool.data_pool);
+            }
+            
+            delegate_invoke(component_pool.fn_reset_type_index);
+        }
+        
+        if (entity_registry->archetype_storage)
+        {
+            archetype_storage_free(entity_registry->archetype_storage);
+            delete entity_registry->archetype_storage;
+            entity_registry->archetype_storage = nullptr;
+        }
+        
+        // Leaves the registry as entity_registry_init found it, the component types get registered again after it
+        entity_registry->entity_groups.clear();
+        
+        for (Array<EntityGroup*>& groups : entity_registry->groups_by_component)
+        {
+            groups.clear();
+        }
+        
+        pool_free(&entity_registry->entities);
+        delete[] entity_registry->component_pool;
+        entity_registry->component_pool            = nullptr;
+        entity_registry->next_component_type_index = 1;
+        entity_registry->entity_count              = 0;
+    }
+
+    u32 entity_change_tick()
+    {
+        NIT_CHECK_ENTITY_REGISTRY_CREATED
+        return entity_registry->change_tick;
+    }
+
+    u32 entity_advance_change_tick()
+    {
+        NIT_CHECK_ENTITY_REGISTRY_CREATED
+        return entity_registry->change_tick++;
+    }
+
+    void component_broadcast_added(ComponentPool* component_pool, EntityID entity)
+    {
+        NIT_CHECK_ENTITY_REGISTRY_CREATED
+        const ComponentAddedArgs args { entity, component_pool->data_pool.type };
+        event_broadcast<const ComponentAddedArgs&>(component_pool->added_event, args);
+        event_broadcast<const ComponentAddedArgs&>(entity_registry->component_added_event, args);
+        event_queue_push(component_pool->added_queue, entity);
+    }
+
+    void component_broadcast_removed(ComponentPool* component_pool, EntityID entity)
+    {
+        NIT_CHECK_ENTITY_REGISTRY_CREATED
+        const ComponentRemovedArgs args { entity, component_pool->data_pool.type };
+        event_broadcast<const ComponentRemovedArgs&>(component_pool->removed_event, args);
+        event_broadcast<const ComponentRemovedArgs&>(entity_registry->component_removed_event, args);
+    }
+
+    void entity_flush_events()
+    {
+        NIT_CHECK_ENTITY_REGISTRY_CREATED
+        NIT_PROFILE_FUNCTION();
         for (u32 i = 0; i < entity_registry->next_component_type_index - 1; ++i)
         {
-            ComponentPool& data = entity_registry->component_pool[i];
-            pool_free(&data.data_pool);
+            ComponentPool& component_pool = entity_registry->component_pool[i];
+            
+            event_queue_flush(component_pool.added_queue, [&component_pool](Array<EntityID>& entities)
+            {
+                std::sort(entities.begin(), entities.end(), [](EntityID a, EntityID b)
+                {
+                    return entity_index(a) != entity_index(b) ? entity_index(a) < entity_index(b) : a < b;
+                });
+                
+                entities.erase(std::unique(entities.begin(), entities.end()), entities.end());
+                
+                std::erase_if(entities, [&component_pool](EntityID entity)
+                {
+                    return !entity_valid(entity) || !entity_registry->signatures[entity_index(entity)].test(component_pool.type_index);
+                });
+            });
         }
     }
 
@@ -138,13 +288,20 @@ namespace nit
     {
         NIT_CHECK_ENTITY_REGISTRY_CREATED
         NIT_CHECK_MSG(entity_registry->entity_count < entity_registry->max_entities, "Entity limit reached!");
-        EntityID entity; pool_insert_data(&entity_registry->entities, entity);
+        const u32 index = pool_next_id(&entity_registry->entities);
+        u8& generation  = entity_registry->generations[index];
+        generation &= ~ENTITY_FREE_BIT;
+        const EntityID entity = entity_make_handle(index, generation);
+        pool_insert_data_with_id(&entity_registry->entities, entity);
         ++entity_registry->entity_count;
         EntityData* data = pool_get_data<EntityData>(&entity_registry->entities, entity);
         data->id = entity;
-        data->name = name.empty() ? String("Entity ").append(std::to_string(entity)) : name;
+        data->name = name.empty() ? String("Entity ").append(std::to_string(index)) : name;
         data->uuid = uuid_generate();
-        data->signature.set(0, true);
+        entity_registry->signatures[entity_index(entity)].set(0, true);
+        entity_registry->parents[entity_index(entity)] = NULL_ENTITY;
+        entity_bit_set(entity_registry->enabled_bits, entity, true);
+        entity_bit_set(entity_registry->global_enabled_bits, entity, true);
         return entity;
     }
 
@@ -157,31 +314,38 @@ namespace nit
         {
             ComponentPool& component_pool = entity_registry->component_pool[i];
 
-            if (!pool_get_data<EntityData>(&entity_registry->entities, entity)->signature.test(i + 1))
+            if (!entity_registry->signatures[entity_index(entity)].test(i + 1))
             {
                 continue;
             }
 
-            event_broadcast<const ComponentRemovedArgs&>(entity_registry->component_removed_event, {entity, component_pool.data_pool.type});
+            component_broadcast_removed(&component_pool, entity);
         }
         
-        for (u32 i = 0; i < entity_registry->next_component_type_index - 1; ++i)
+        if (entity_registry->archetype_storage)
         {
-            ComponentPool& component_pool = entity_registry->component_pool[i];
-
-            if (!pool_get_data<EntityData>(&entity_registry->entities, entity)->signature.test(i + 1))
+            archetype_remove_entity(entity_registry->archetype_storage, entity);
+        }
+        else
+        {
+            for (u32 i = 0; i < entity_registry->next_component_type_index - 1; ++i)
             {
-                continue;
-            }
+                ComponentPool& component_pool = entity_registry->component_pool[i];
+
+                if (!entity_registry->signatures[entity_index(entity)].test(i + 1))
+                {
+                    continue;
+                }
 
-            pool_delete_data(&component_pool.data_pool, entity);
+                pool_delete_data(&component_pool.data_pool, entity);
+            }
         }
 
         EntityData* entity_data = pool_get_data<EntityData>(&entity_registry->entities, entity); 
 
-        if (entity_valid(entity_data->parent))
+        if (entity_valid(entity_registry->parents[entity_index(entity)]))
         {
-            entity_remove_child(entity_data->parent, entity);
+            entity_remove_child(entity_registry->parents[entity_index(entity)], entity);
         }
 
         if (result)
@@ -196,52 +360,190 @@ namespace nit
         }
         
         pool_delete_data(&entity_registry->entities, entity);
+        entity_registry->signatures[entity_index(entity)] = {};
+        entity_registry->parents[entity_index(entity)]    = NULL_ENTITY;
+        entity_bit_set(entity_registry->enabled_bits, entity, false);
+        entity_bit_set(entity_registry->global_enabled_bits, entity, false);
+        entity_registry->generations[entity_index(entity)] = ENTITY_FREE_BIT | ((entity_generation(entity) + 1) & ENTITY_GENERATION_MASK);
         
         --entity_registry->entity_count;
 
-        for (auto& [signature, group] : entity_registry->entity_groups)
+        for (EntityGroup* group : entity_registry->groups_by_component[0])
         {
-            group.entities.erase(entity);
+            if (sparse_test(&group->entities, entity))
+            {
+                sparse_remove(&group->entities, entity);
+            }
         }
     }
 
     bool entity_valid(const EntityID entity)
     {
         NIT_CHECK_ENTITY_REGISTRY_CREATED
-        return entity < entity_registry->max_entities && pool_is_valid(&entity_registry->entities, entity);
+        // Pending entities and NULL_ENTITY have the top bit set, so they never match a generation
+        const u32 generation = entity >> ENTITY_INDEX_BITS;
+        return generation < ENTITY_FREE_BIT && entity_index(entity) < entity_registry->max_entities && entity_registry->generations[entity_index(entity)] == generation;
     }
 
-    void entity_signature_changed(EntityID entity, EntitySignature new_entity_signature)
+    void entity_signature_changed(EntityID entity, const EntitySignature& new_entity_signature, u32 type_index)
     {
         NIT_CHECK_ENTITY_REGISTRY_CREATED
-        for (auto& [signature, group] : entity_registry->entity_groups)
+        // Membership can only change for the groups that contain the modified component,
+        // type index 0 is the validity bit that every group has so it re-evaluates all of them
+        for (EntityGroup* group : entity_registry->groups_by_component[type_index])
         {
-            if ((signature | new_entity_signature) == new_entity_signature)
+            const bool is_member = sparse_test(&group->entities, entity);
+            
+            if (entity_signature_contains(new_entity_signature, group->signature))
             {
-                group.entities.insert(entity);
+                if (!is_member)
+                {
+                    sparse_insert(&group->entities, entity);
+                }
                 continue;
             }
 
-            group.entities.erase(entity);
+            if (is_member)
+            {
+                sparse_remove(&group->entities, entity);
+            }
+        }
+    }
+
+    static constexpr u32 GROUP_BACKFILL_BATCH_SIZE = 4096;
+
+    // Adds the existing entities that match a new group. With pool storage the candidates are the members of the
+    // smallest pool of the group (every entity for groups without components), checked across the job system
+    // and inserted afterwards. With archetype storage the rows of the matching archetypes already are the members.
+    static void group_backfill(EntityGroup* group)
+    {
+        if (entity_registry->entity_count == 0)
+        {
+            return;
+        }
+
+        if (entity_registry->storage == EntityStorage::Archetype && group->signature != EntitySignature{}.set(0))
+        {
+            for (const Archetype* archetype : entity_registry->archetype_storage->archetypes)
+            {
+                if (!entity_signature_contains(archetype->signature, group->signature))
+                {
+                    continue;
+                }
+                
+                sparse_reserve(&group->entities, group->entities.count + archetype->count);
+                
+                for (u32 row = 0; row < archetype->count; ++row)
+                {
+                    sparse_insert(&group->entities, archetype_row_entity(archetype, row));
+                }
+            }
+            return;
+        }
+        
+        const SparseSet* driver = &entity_registry->entities.sparse_set;
+
+        if (entity_registry->storage == EntityStorage::Pool)
+        {
+            for (u32 i = 0; i < entity_registry->next_component_type_index - 1; ++i)
+            {
+                const SparseSet* candidate = &entity_registry->component_pool[i].data_pool.sparse_set;
+                
+                if (group->signature.test(entity_registry->component_pool[i].type_index) && candidate->count < driver->count)
+                {
+                    driver = candidate;
+                }
+            }
         }
+
+        const EntitySignature& signature = group->signature;
+        const EntitySignature* signatures = entity_registry->signatures;
+        Array<u8> matches(driver->count);
+
+        parallel_for(driver->count, GROUP_BACKFILL_BATCH_SIZE, [&](u32 i)
+        {
+            matches[i] = entity_signature_contains(signatures[entity_index(driver->dense[i])], signature);
+        });
+
+        for (u32 i = 0; i < driver->count; ++i)
+        {
+            if (matches[i])
+            {
+                sparse_insert(&group->entities, driver->dense[i]);
+            }
+        }
+    }
+    
+    static EntityGroup* create_group(const EntitySignature& signature, bool on_demand)
+    {
+        EntityGroup* group = &entity_registry->entity_groups[signature];
+        group->signature       = signature;
+        group->on_demand       = on_demand;
+        group->last_used_frame.store(entity_registry->group_frame, std::memory_order_relaxed);
+        group->entities.tag    = MemoryTag::Entity;
+        sparse_load(&group->entities, entity_registry->max_entities);
+
+        for (u32 type_index = 0; type_index < NIT_MAX_COMPONENT_TYPES + 1; ++type_index)
+        {
+            if (signature.test(type_index))
+            {
+                entity_registry->groups_by_component[type_index].push_back(group);
+            }
+        }
+
+        group_backfill(group);
+        return group;
     }
 
     EntitySignature entity_create_group(const Array<u64>& type_hashes)
     {
         NIT_CHECK_ENTITY_REGISTRY_CREATED
-        NIT_CHECK_MSG(!entity_registry->entity_count, "Create the group before any entity gets created!");
+        NIT_CHECK_MSG(!entity_registry->concurrent_systems, "Groups can't be created while concurrent systems run!");
         EntitySignature group_signature = entity_build_signature(type_hashes);
 
-        if (entity_registry->entity_groups.count(group_signature) != 0)
+        if (auto it = entity_registry->entity_groups.find(group_signature); it != entity_registry->entity_groups.end())
         {
+            it->second.on_demand = false;
             return group_signature;
         }
         
-        EntityGroup* group = &entity_registry->entity_groups[group_signature];
-        group->signature = group_signature;
+        create_group(group_signature, false);
         return group_signature;
     }
 
+    void entity_collect_groups()
+    {
+        NIT_CHECK_ENTITY_REGISTRY_CREATED
+        ++entity_registry->group_frame;
+
+        if (entity_registry->group_gc_frames == 0)
+        {
+            return;
+        }
+
+        for (auto it = entity_registry->entity_groups.begin(); it != entity_registry->entity_groups.end();)
+        {
+            EntityGroup& group = it->second;
+
+            if (!group.on_demand || entity_registry->group_frame - group.last_used_frame.load(std::memory_order_relaxed) < entity_registry->group_gc_frames)
+            {
+                ++it;
+                continue;
+            }
+
+            for (u32 type_index = 0; type_index < NIT_MAX_COMPONENT_TYPES + 1; ++type_index)
+            {
+                if (group.signature.test(type_index))
+                {
+                    std::erase(entity_registry->groups_by_component[type_index], &group);
+                }
+            }
+
+            sparse_release(&group.entities);
+            it = entity_registry->entity_groups.erase(it);
+        }
+    }
+
     void entity_create_preset(const String& name, const Array<u64>& type_hashes)
     {
         NIT_CHECK_ENTITY_REGISTRY_CREATED
@@ -272,42 +574,42 @@ namespace nit
     bool entity_enabled(EntityID entity)
     {
         NIT_CHECK_ENTITY_REGISTRY_CREATED
-        EntityData* data = pool_get_data<EntityData>(&entity_registry->entities, entity);
-        return data->enabled;
+        return entity_bit_test(entity_registry->enabled_bits, entity);
     }
 
     bool entity_global_enabled(EntityID entity)
     {
         NIT_CHECK_ENTITY_REGISTRY_CREATED
-        EntityData* data = pool_get_data<EntityData>(&entity_registry->entities, entity);
-        return data->global_enabled && data->enabled;
+        return entity_bit_test(entity_registry->global_enabled_bits, entity) && entity_bit_test(entity_registry->enabled_bits, entity);
     }
 
     static void compute_enabled_iterative(EntityID entity)
     {
-        Stack<EntityID> stack;
-        stack.push(entity);
+        ArenaScope temp_scope;
+        ArenaArray<EntityID> stack(temp_scope.arena);
+        stack.reserve(64);
+        stack.push_back(entity);
         
         while (!stack.empty())
         {
-            EntityID current = stack.top();
-            stack.pop();
-
-            EntityData* data = pool_get_data<EntityData>(&entity_registry->entities, current);
+            EntityID current = stack.back();
+            stack.pop_back();
 
-            EntityID parent = data->parent;
+            EntityID parent = entity_registry->parents[entity_index(current)];
             
             bool parent_enabled = entity_valid(parent) ? entity_global_enabled(parent) : true;
 
-            bool new_global_enabled = data->enabled && parent_enabled;
+            bool new_global_enabled = entity_enabled(current) && parent_enabled;
             
-            if (data->global_enabled != new_global_enabled)
+            if (entity_bit_test(entity_registry->global_enabled_bits, current) != new_global_enabled)
             {
-                data->global_enabled = new_global_enabled;
+                entity_bit_set(entity_registry->global_enabled_bits, current, new_global_enabled);
 
+                EntityData* data = pool_get_data<EntityData>(&entity_registry->entities, current);
+                
                 for (EntityID child : data->children)
                 {
-                    stack.push(child);
+                    stack.push_back(child);
                 }
             }
         }
@@ -315,14 +617,12 @@ namespace nit
 
     void entity_set_enabled(EntityID entity, bool enabled)
     {
-        EntityData* data = pool_get_data<EntityData>(&entity_registry->entities, entity);
-        
-        if (data->enabled == enabled)
+        if (entity_enabled(entity) == enabled)
         {
             return;
         }
         
-        data->enabled = enabled;
+        entity_bit_set(entity_registry->enabled_bits, entity, enabled);
         compute_enabled_iterative(entity);
     }
 
@@ -367,23 +667,29 @@ namespace nit
         children = data->children;
     }
 
-    void entity_set_parent(EntityID entity, EntityID parent)
+    void entity_get_children(EntityID entity, ArenaArray<EntityID>& children)
     {
         NIT_CHECK_ENTITY_REGISTRY_CREATED
         EntityData* data = pool_get_data<EntityData>(&entity_registry->entities, entity);
-        if (entity_valid(data->parent))
+        children.assign(data->children.begin(), data->children.end());
+    }
+
+    void entity_set_parent(EntityID entity, EntityID parent)
+    {
+        NIT_CHECK_ENTITY_REGISTRY_CREATED
+        EntityID& current_parent = entity_registry->parents[entity_index(entity)];
+        if (entity_valid(current_parent))
         {
-            entity_remove_child(data->parent, entity);
+            entity_remove_child(current_parent, entity);
         }
-        data->parent = parent;
+        current_parent = parent;
         entity_add_child(parent, entity);
     }
 
     EntityID entity_get_parent(EntityID entity)
     {
         NIT_CHECK_ENTITY_REGISTRY_CREATED
-        EntityData* data = pool_get_data<EntityData>(&entity_registry->entities, entity);
-        return data->parent;
+        return entity_registry->parents[entity_index(entity)];
     }
 
     void entity_remove_child(EntityID entity, EntityID child)
@@ -404,10 +710,68 @@ namespace nit
         return { (EntityData*) entity_registry->entities.elements, entity_registry->entity_count };
     }
 
-    EntityGroup& entity_get_group(EntitySignature signature)
+    EntityGroup& entity_get_group(const EntitySignature& signature)
     {
         NIT_CHECK_ENTITY_REGISTRY_CREATED
-        return entity_registry->entity_groups[signature];
+        auto it = entity_registry->entity_groups.find(signature);
+
+        if (it == entity_registry->entity_groups.end())
+        {
+            // Inserting into entity_groups would race with the lookups of the systems running on other threads, the
+            // main thread included since job_wait runs systems of the same batch on it
+            if (entity_registry->concurrent_systems)
+            {
+                static EntityGroup empty_group;
+                std::lock_guard lock(entity_registry->deferred_groups_mutex);
+                Array<EntitySignature>& deferred_groups = entity_registry->deferred_groups;
+
+                if (std::find(deferred_groups.begin(), deferred_groups.end(), signature) == deferred_groups.end())
+                {
+                    deferred_groups.push_back(signature);
+                }
+
+                return empty_group;
+            }
+
+            NIT_CHECK_MSG(job_thread_index() == 0, "On demand groups can only be created from the main thread!");
+            return *create_group(signature, true);
+        }
+
+        // Every caller of the frame stores the same value, skipping the store keeps the cache line shared
+        EntityGroup& group = it->second;
+        const u32 group_frame = entity_registry->group_frame;
+
+        if (group.last_used_frame.load(std::memory_order_relaxed) != group_frame)
+        {
+            group.last_used_frame.store(group_frame, std::memory_order_relaxed);
+        }
+
+        return group;
+    }
+
+    void entity_begin_concurrent_systems()
+    {
+        NIT_CHECK_ENTITY_REGISTRY_CREATED
+        NIT_CHECK_MSG(!entity_registry->concurrent_systems, "Concurrent systems already running!");
+        entity_registry->concurrent_systems = true;
+    }
+
+    void entity_end_concurrent_systems()
+    {
+        NIT_CHECK_ENTITY_REGISTRY_CREATED
+        NIT_CHECK_MSG(entity_registry->concurrent_systems, "Concurrent systems are not running!");
+        entity_registry->concurrent_systems = false;
+
+        // The workers are done, nobody else touches the list
+        for (const EntitySignature& signature : entity_registry->deferred_groups)
+        {
+            if (!entity_registry->entity_groups.contains(signature))
+            {
+                create_group(signature, true);
+            }
+        }
+
+        entity_registry->deferred_groups.clear();
     }
 
     EntityID entity_create_from_preset(const String& name)
@@ -458,13 +822,14 @@ namespace nit
 
             emitter << YAML::Key << data_pool.type->name << YAML::Value << YAML::BeginMap;
                 
-            void* raw_data = pool_get_raw_data(&data_pool, entity);
-            serialize(data_pool.type, raw_data, emitter);
+            const void* raw_data = delegate_invoke(component_pool.fn_get_const_from_entity, entity);
+            serialize(data_pool.type, const_cast<void*>(raw_data), emitter);
                 
             emitter << YAML::EndMap;
         }
         
-        Array<EntityID> children;
+        ArenaScope temp_scope;
+        ArenaArray<EntityID> children(temp_scope.arena);
         entity_get_children(entity, children);
         
         if (!children.empty())
@@ -505,10 +870,10 @@ namespace nit
         
         if (node["Enabled"])
         {
-            data->enabled = node["Enabled"].as<bool>();
+            entity_bit_set(entity_registry->enabled_bits, entity, node["Enabled"].as<bool>());
         }
 
-        data->parent = parent;
+        entity_registry->parents[entity_index(entity)] = parent;
 
         if (entity_valid(parent))
         {
@@ -541,10 +906,7 @@ namespace nit
             delegate_invoke(component_pool->fn_add_to_entity, entity, null_data, false);
             void* component_data = delegate_invoke(component_pool->fn_get_from_entity, entity);
             deserialize(data_pool.type, component_data, component_node);
-            ComponentAddedArgs args;
-            args.entity = entity;
-            args.type = component_pool->data_pool.type;
-            event_broadcast<const ComponentAddedArgs&>(entity_registry_get_instance()->component_added_event, args);
+            component_broadcast_added(component_pool, entity);
         }
         
         return entity;
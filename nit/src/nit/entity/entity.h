@@ -1,4 +1,6 @@
 ﻿#pragma once
+#include <atomic>
+#include <mutex>
 
 #ifndef NIT_MAX_COMPONENT_TYPES
     #define NIT_MAX_COMPONENT_TYPES 100
@@ -10,38 +12,120 @@ namespace nit
     
     using EntityID = u32;
 
-    // First bit of the signature would be used to know if the entity is valid or not
-    using EntitySignature = Bitset<NIT_MAX_COMPONENT_TYPES + 1>;
+    // Entity handles pack the index of the entity in the low ENTITY_INDEX_BITS and its generation in the next
+    // ENTITY_GENERATION_BITS. The generation gets bumped when the entity is destroyed, so handles kept around stop
+    // being valid instead of aliasing the entity that reuses the index. The top bit is left for the pending entities
+    // of the command buffers (see entity_commands.h). Pools and groups are keyed by the index (see SparseSet).
+    inline constexpr u32 ENTITY_INDEX_BITS      = SparseSet::KEY_BITS;
+    inline constexpr u32 ENTITY_INDEX_MASK      = SparseSet::KEY_MASK;
+    inline constexpr u32 ENTITY_GENERATION_BITS = 7;
+    inline constexpr u32 ENTITY_GENERATION_MASK = (1u << ENTITY_GENERATION_BITS) - 1;
+    inline constexpr u8  ENTITY_FREE_BIT        = 1u << ENTITY_GENERATION_BITS; // Marks the free indices in EntityRegistry::generations
+
+    inline u32      entity_index(EntityID entity)                   { return entity & ENTITY_INDEX_MASK; }
+    inline u32      entity_generation(EntityID entity)              { return (entity >> ENTITY_INDEX_BITS) & ENTITY_GENERATION_MASK; }
+    inline EntityID entity_make_handle(u32 index, u32 generation)   { return index | (generation << ENTITY_INDEX_BITS); }
+
+    // Component mask of an entity, group or archetype. First bit is used to know if the entity is valid or not, the
+    // rest are the component type indices. Stored as plain words so the subset test that decides the group membership
+    // is a couple of ands and no branches (see entity_signature_contains).
+    struct EntitySignature
+    {
+        static constexpr u32 WORD_COUNT = (NIT_MAX_COMPONENT_TYPES + 1 + 63) / 64;
+
+        u64 words[WORD_COUNT] = {};
+
+        bool test(u32 bit) const { return (words[bit >> 6] >> (bit & 63)) & 1; }
+
+        bool any() const
+        {
+            u64 bits = 0;
+            for (u64 word : words) bits |= word;
+            return bits != 0;
+        }
+
+        EntitySignature& set(u32 bit, bool value = true)
+        {
+            const u64 mask = 1ull << (bit & 63);
+            words[bit >> 6] = value ? words[bit >> 6] | mask : words[bit >> 6] & ~mask;
+            return *this;
+        }
+    };
+
+    inline EntitySignature operator|(const EntitySignature& a, const EntitySignature& b)
+    {
+        EntitySignature result;
+        for (u32 i = 0; i < EntitySignature::WORD_COUNT; ++i) result.words[i] = a.words[i] | b.words[i];
+        return result;
+    }
+
+    inline EntitySignature& operator|=(EntitySignature& a, const EntitySignature& b)
+    {
+        for (u32 i = 0; i < EntitySignature::WORD_COUNT; ++i) a.words[i] |= b.words[i];
+        return a;
+    }
+
+    inline EntitySignature operator&(const EntitySignature& a, const EntitySignature& b)
+    {
+        EntitySignature result;
+        for (u32 i = 0; i < EntitySignature::WORD_COUNT; ++i) result.words[i] = a.words[i] & b.words[i];
+        return result;
+    }
+
+    inline bool operator==(const EntitySignature& a, const EntitySignature& b)
+    {
+        u64 diff = 0;
+        for (u32 i = 0; i < EntitySignature::WORD_COUNT; ++i) diff |= a.words[i] ^ b.words[i];
+        return diff == 0;
+    }
+
+    inline bool operator!=(const EntitySignature& a, const EntitySignature& b) { return !(a == b); }
+
+    // True if every bit of subset is set in signature
+    inline bool entity_signature_contains(const EntitySignature& signature, const EntitySignature& subset)
+    {
+        u64 missing = 0;
+        for (u32 i = 0; i < EntitySignature::WORD_COUNT; ++i) missing |= subset.words[i] & ~signature.words[i];
+        return missing == 0;
+    }
+}
+
+template <>
+struct std::hash<nit::EntitySignature>
+{
+    std::size_t operator()(const nit::EntitySignature& signature) const noexcept
+    {
+        u64 seed = 0;
+        for (u64 word : signature.words) seed ^= word + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+        return hash<u64>()(seed);
+    }
+};
+
+namespace nit
+{
     
+    // Cold per entity data, only touched by lookups by name / uuid, the hierarchy and serialization. The data every
+    // system checks per entity (signature, enabled flags and parent) lives in the arrays of the registry (see
+    // EntityRegistry::signatures) so those checks do not pull the name and the children through the cache.
     struct EntityData
     {
         EntityID         id             = NULL_ENTITY;
-        bool             enabled        = true;
-        bool             global_enabled = true;
-        EntitySignature  signature      = {};
         String           name;
         UUID             uuid           = {0};
-        EntityID         parent         = NULL_ENTITY;
         Array<EntityID>  children       = {};
     };
+
+    // Packed per entity flags, 64 entities per word
+    inline u32  entity_bit_words(u32 max_entities)                  { return (max_entities + 63) / 64; }
+    inline bool entity_bit_test(const u64* bits, EntityID entity)   { return (bits[entity_index(entity) >> 6] >> (entity & 63)) & 1; }
     
-    struct ComponentPool
+    inline void entity_bit_set(u64* bits, EntityID entity, bool value)
     {
-        u32                           type_index  = 0;
-        Pool                          data_pool;
-        
-        Delegate<void(EntityID, void*, bool)> fn_add_to_entity;
-        Delegate<void(EntityID)>              fn_remove_from_entity;
-        Delegate<bool(EntityID)>              fn_is_in_entity;
-        Delegate<void*(EntityID)>             fn_get_from_entity;
-    };
+        const u32 word = entity_index(entity) >> 6;
+        const u64 mask = 1ull << (entity & 63);
+        bits[word] = value ? bits[word] | mask : bits[word] & ~mask;
+    }
     
-    struct EntityGroup
-    {
-        EntitySignature   signature;
-        Set<EntityID>     entities;
-    };
-
     struct ComponentAddedArgs
     {
         EntityID entity = 0;
@@ -58,29 +142,122 @@ namespace nit
     using ComponentRemovedListener = Listener<const ComponentRemovedArgs&>; 
     using ComponentAddedEvent      = Event<const ComponentAddedArgs&>;
     using ComponentRemovedEvent    = Event<const ComponentRemovedArgs&>;
+    using ComponentBatchListener   = Listener<const EntityID*, u32>;
+    using ComponentBatchEvent      = Event<const EntityID*, u32>;
+
+    struct ComponentPool
+    {
+        u32                           type_index   = 0;
+        Pool                          data_pool;
+        u32**                         change_ticks = nullptr; // Entity -> change tick of the last mutable access, paged like SparseSet
+        ComponentAddedEvent           added_event;            // Adds of this type only, see entity_on_add
+        ComponentRemovedEvent         removed_event;          // Removes of this type only, see entity_on_remove
+        EventQueue<EntityID>          added_queue;            // Adds of this type delivered in batches, see entity_on_add_batch
+        
+        Delegate<void(EntityID, void*, bool)> fn_add_to_entity;
+        Delegate<void(EntityID)>              fn_remove_from_entity;
+        Delegate<bool(EntityID)>              fn_is_in_entity;
+        Delegate<void*(EntityID)>             fn_get_from_entity;       // Stamps the component as changed
+        Delegate<const void*(EntityID)>       fn_get_const_from_entity; // Read only, see entity_get_const
+        Delegate<void(void*)>                 fn_on_prefab_copy;        // Clears the state a prefab copy can't share, see prefab_load
+        Delegate<void(void*, const void*)>    fn_on_recycle;            // Writes the prefab data keeping that state, see EntityRecycler
+        Delegate<void()>                      fn_reset_type_index;      // Clears component_type_index<T>, see entity_registry_finish
+    };
+
+    // Change tick slot of the entity, the page gets allocated on the first write (entity_add)
+    inline u32& component_change_tick(ComponentPool* component_pool, EntityID entity)
+    {
+        entity = entity_index(entity);
+        u32*& page = component_pool->change_ticks[entity / SparseSet::PAGE_SIZE];
+        
+        if (!page)
+        {
+            page = memory_new_array<u32>(MemoryTag::Entity, SparseSet::PAGE_SIZE);
+        }
+        
+        return page[entity % SparseSet::PAGE_SIZE];
+    }
+    
+    // Entities are kept packed in the dense array of the sparse set, so membership changes are O(1) and
+    // iterating a group walks a contiguous array. Removing members while iterating reorders the group.
+    // Groups created by entity_get_group are on demand, they get destroyed by entity_collect_groups once nobody
+    // asked for them during EntityRegistry::group_gc_frames frames.
+    struct EntityGroup
+    {
+        EntitySignature   signature;
+        SparseSet         entities;
+        bool              on_demand       = false;
+        std::atomic<u32>  last_used_frame = 0; // Stamped by entity_get_group, which concurrent systems call
+    };
+
+    struct ArchetypeStorage;
+
+    // Pool keeps one sparse set per component type, with the components in chunks that do not move when the pool
+    // grows (see component_chunk_bytes), so references only go stale when the last component of the type gets
+    // moved into a removed slot. Archetype packs the entities that share a signature in
+    // chunked columns (see archetype.h), adding or removing a component moves the entity to another archetype,
+    // so component references are not stable across entity_add / entity_remove in that mode.
+    enum class EntityStorage : u8
+    {
+        Pool,
+        Archetype
+    };
     
     struct EntityRegistry
     {
         Pool                              entities;
         u32                               entity_count = 0;
         Map<EntitySignature, EntityGroup> entity_groups;
+        Array<EntityGroup*>               groups_by_component[NIT_MAX_COMPONENT_TYPES + 1]; // Type index -> groups that contain it, index 0 (validity bit) lists all of them
+        u32                               group_frame     = 0;   // Advanced by entity_collect_groups
+        u32                               group_gc_frames = 120; // Unused frames before an on demand group gets destroyed, 0 keeps them
+        bool                              concurrent_systems = false; // Set while engine_broadcast_concurrent runs a batch, see entity_get_group
+        std::mutex                        deferred_groups_mutex;
+        Array<EntitySignature>            deferred_groups;            // On demand groups requested during the batch
         Map<String, Array<u64>>           entity_presets;
         ComponentPool*                    component_pool;
         u32                               next_component_type_index = 1;
         ComponentAddedEvent               component_added_event;
         ComponentRemovedEvent             component_removed_event;
         u32                               max_entities = 100000;
+        EntityStorage                     storage      = EntityStorage::Pool;
+        ArchetypeStorage*                 archetype_storage = nullptr;
+        u32                               change_tick  = 1;
+        u32                               component_chunk_bytes = 16 * 1024; // Block size of the component pools, 0 makes them contiguous (see Pool)
+        struct EntityCommandBuffer*       command_buffers[2] = {};  // One buffer per job thread, a set records while the other plays back
+        u32                               command_buffer_count = 0;
+        u32                               recording_buffers    = 0;
+        u8*                               generations         = nullptr; // Index -> generation, plus ENTITY_FREE_BIT while the index is free
+        EntitySignature*                  signatures          = nullptr; // Index -> signature
+        EntityID*                         parents             = nullptr; // Index -> parent
+        u64*                              enabled_bits        = nullptr; // See entity_bit_test
+        u64*                              global_enabled_bits = nullptr; // Cleared while an ancestor is disabled
     };
 
     void            entity_registry_set_instance(EntityRegistry* entity_registry_instance);
     EntityRegistry* entity_registry_get_instance();
-    
+
+    // Component slot assigned once by component_register<T>, 0 means the component is not registered.
+    // entity_registry_finish clears it again, so a registry can be initialized anew and register the type again.
+    // Lets the templated entity functions reach the pool and the signature bit without hashing the type.
+    template<typename T>
+    inline u32 component_type_index = 0;
+
+    void* entity_archetype_get(EntityID entity, u32 type_index);
+    void* entity_archetype_insert(EntityID entity, u32 type_index, void* data);
+    void  entity_archetype_erase(EntityID entity, u32 type_index);
     
     template<typename T>
     void entity_remove(EntityID entity);
 
     template<typename T>
     T* entity_get_ptr(EntityID entity);
+
+    template<typename T>
+    const T& entity_get_const(EntityID entity);
+
+    template<typename T>
+    void entity_mark_changed(EntityID entity);
         
     template<typename T>
     bool entity_has(EntityID entity);
@@ -93,6 +270,7 @@ namespace nit
     {
         EntityRegistry* entity_registry = entity_registry_get_instance(); 
         NIT_CHECK_MSG(entity_registry->next_component_type_index <= NIT_MAX_COMPONENT_TYPES, "Components out of range!");
+        NIT_CHECK_MSG(component_type_index<T> == 0, "Component already registered!");
 
         if (!type_exists<T>())
         {
@@ -125,22 +303,44 @@ namespace nit
         void* (*fn_get_from_entity)(EntityID) = [](EntityID entity) -> void* {
             return entity_get_ptr<T>(entity);
         };
+
+        const void* (*fn_get_const_from_entity)(EntityID) = [](EntityID entity) -> const void* {
+            return &entity_get_const<T>(entity);
+        };
+
+        void (*fn_reset_type_index)() = [] {
+            component_type_index<T> = 0;
+        };
         
         delegate_bind(component_pool.fn_add_to_entity, fn_add_to_entity);
         delegate_bind(component_pool.fn_remove_from_entity, fn_remove_from_entity);
         delegate_bind(component_pool.fn_is_in_entity, fn_is_in_entity);
         delegate_bind(component_pool.fn_get_from_entity, fn_get_from_entity);
+        delegate_bind(component_pool.fn_get_const_from_entity, fn_get_const_from_entity);
+        delegate_bind(component_pool.fn_reset_type_index, fn_reset_type_index);
         
-        pool_load<T>(&component_pool.data_pool, entity_registry->max_entities, false);
+        if (entity_registry->storage == EntityStorage::Archetype)
+        {
+            component_pool.data_pool.type = type_get<T>();
+        }
+        else
+        {
+            const u32 chunk_bytes    = entity_registry->component_chunk_bytes;
+            const u32 chunk_capacity = chunk_bytes != 0 ? std::max<u32>(chunk_bytes / sizeof(T), 1) : 0;
+            component_pool.data_pool.tag = MemoryTag::Entity;
+            pool_load<T>(&component_pool.data_pool, entity_registry->max_entities, false, chunk_capacity);
+        }
+        
+        component_pool.change_ticks = memory_new_array<u32*>(MemoryTag::Entity, sparse_page_count(entity_registry->max_entities));
+        component_type_index<T> = component_pool.type_index;
         ++entity_registry->next_component_type_index;
     }
 
     template<typename T>
     u32 entity_component_type_index()
     {
-        ComponentPool* component_pool = entity_find_component_pool<T>();
-        NIT_CHECK_MSG(component_pool, "Component type is not registered!");
-        return component_pool->type_index;
+        NIT_CHECK_MSG(component_type_index<T> != 0, "Component type is not registered!");
+        return component_type_index<T>;
     }
     
     void            entity_registry_init();
@@ -152,14 +352,67 @@ namespace nit
     void                entity_destroy(EntityID entity, EntityDestroyResult* result = nullptr);
     bool                entity_valid(EntityID entity);
     EntitySignature     entity_get_signature(EntityID entity);
-    void                entity_signature_changed(EntityID entity, EntitySignature new_entity_signature);
+    void                entity_signature_changed(EntityID entity, const EntitySignature& new_entity_signature, u32 type_index = 0);
     ComponentPool*      entity_find_component_pool(const Type* type);
     EntityID            entity_clone(EntityID entity, const Vector3& position = V3_ZERO);
+
+    // Change detection. Mutable accesses (entity_add, entity_get, entity_get_ptr and the non const components of
+    // entity_view) stamp the component of the entity with the current change tick. A system keeps the tick returned
+    // by entity_advance_change_tick at the end of its run and asks entity_changed<T>(entity, last_tick) next time.
+    // Reads should go through entity_get_const or const view components, or the component shows up as changed. The
+    // stamp is a plain store, so concurrent writers (parallel_for over a view) must each own a disjoint set of entities.
+    u32                 entity_change_tick();
+    u32                 entity_advance_change_tick();
+
+    // Broadcasts to the observers of the component type and then to component_added_event / component_removed_event,
+    // adds also get queued for the batch observers (see entity_on_add_batch)
+    void                component_broadcast_added(ComponentPool* component_pool, EntityID entity);
+    void                component_broadcast_removed(ComponentPool* component_pool, EntityID entity);
+
+    // Delivers the queued adds to the batch observers, the engine calls it at the end of every stage
+    void                entity_flush_events();
     
     template<typename T>
     ComponentPool* entity_find_component_pool()
     {
-        return entity_find_component_pool(type_get<T>());
+        const u32 type_index = component_type_index<T>;
+        
+        if (type_index == 0)
+        {
+            return nullptr;
+        }
+        
+        return &entity_registry_get_instance()->component_pool[type_index - 1];
+    }
+
+    // Observers of a single component type, so systems do not have to filter the adds and removes of every type:
+    //
+    //     entity_on_add<Sprite>() += ComponentAddedListener::create(on_sprite_added);
+    template<typename T>
+    ComponentAddedEvent& entity_on_add()
+    {
+        ComponentPool* component_pool = entity_find_component_pool<T>();
+        NIT_CHECK_MSG(component_pool, "Invalid component type!");
+        return component_pool->added_event;
+    }
+
+    template<typename T>
+    ComponentRemovedEvent& entity_on_remove()
+    {
+        ComponentPool* component_pool = entity_find_component_pool<T>();
+        NIT_CHECK_MSG(component_pool, "Invalid component type!");
+        return component_pool->removed_event;
+    }
+
+    // Queued version of entity_on_add. The listeners get the entities that got the component since the last
+    // entity_flush_events in one call, sorted by index and without the ones that got destroyed or lost the
+    // component in between. Removes are always immediate, the component data is gone after them.
+    template<typename T>
+    ComponentBatchEvent& entity_on_add_batch()
+    {
+        ComponentPool* component_pool = entity_find_component_pool<T>();
+        NIT_CHECK_MSG(component_pool, "Invalid component type!");
+        return component_pool->added_queue.event;
     }
 
     EntitySignature entity_build_signature(const Array<u64>& type_hashes);
@@ -167,28 +420,36 @@ namespace nit
     template <typename... T>
     EntitySignature entity_build_signature()
     {
-        Array<u64> type_hashes = { get_type_hash<T>()... };
-        return entity_build_signature(type_hashes);
+        EntitySignature signature;
+        signature.set(0, true);
+        (signature.set(component_type_index<T>, true), ...);
+        return signature;
     }
 
     template <typename T>
     T& entity_add(EntityID entity, const T& data, bool invoke_add_event)
     {
         NIT_CHECK_MSG(entity_valid(entity), "Invalid entity!");
-        NIT_CHECK_MSG(pool_get_data<EntityData>(&entity_registry_get_instance()->entities, entity)->signature.size() <= NIT_MAX_COMPONENT_TYPES + 1, "Components per entity out of range!");
         ComponentPool* component_pool = entity_find_component_pool<T>();
         NIT_CHECK_MSG(component_pool, "Invalid component type!");
-        T* element = pool_insert_data_with_id(&component_pool->data_pool, entity, data);
-        EntitySignature& signature = pool_get_data<EntityData>(&entity_registry_get_instance()->entities, entity)->signature;
-        signature.set(entity_component_type_index<T>(), true);
-        entity_signature_changed(entity, signature);
-        ComponentAddedArgs args;
-        args.entity = entity;
-        args.type = component_pool->data_pool.type;
+        const bool use_archetypes = entity_registry_get_instance()->storage == EntityStorage::Archetype;
+        T* element = use_archetypes
+            ? static_cast<T*>(entity_archetype_insert(entity, component_pool->type_index, (void*) &data))
+            : pool_insert_data_with_id(&component_pool->data_pool, entity, data);
+        component_change_tick(component_pool, entity) = entity_registry_get_instance()->change_tick;
+        EntitySignature& signature = entity_registry_get_instance()->signatures[entity_index(entity)];
+        signature.set(component_pool->type_index, true);
+        entity_signature_changed(entity, signature, component_pool->type_index);
 
         if (invoke_add_event)
         {
-            event_broadcast<const ComponentAddedArgs&>(entity_registry_get_instance()->component_added_event, args);
+            component_broadcast_added(component_pool, entity);
+
+            if (use_archetypes)
+            {
+                // Listeners could have moved the entity to another archetype
+                element = entity_get_ptr<T>(entity);
+            }
         }
         return *element;
     }
@@ -197,28 +458,30 @@ namespace nit
     void entity_remove(EntityID entity)
     {
         NIT_CHECK_MSG(entity_valid(entity), "Invalid entity!");
-        NIT_CHECK_MSG(entity < entity_registry_get_instance()->max_entities, "Entity out of range!");
+        NIT_CHECK_MSG(entity_index(entity) < entity_registry_get_instance()->max_entities, "Entity out of range!");
         ComponentPool* component_pool = entity_find_component_pool<T>();
         NIT_CHECK_MSG(component_pool, "Invalid component type!");
 
-        ComponentRemovedArgs args;
-        args.entity = entity;
-        args.type = component_pool->data_pool.type;
-        event_broadcast<const ComponentRemovedArgs&>(entity_registry_get_instance()->component_removed_event, args);
+        component_broadcast_removed(component_pool, entity);
 
-        pool_delete_data(&component_pool->data_pool, entity);
-        EntitySignature& signature = pool_get_data<EntityData>(&entity_registry_get_instance()->entities, entity)->signature;
-        signature.set(entity_component_type_index<T>(), false);
-        entity_signature_changed(entity, signature);
+        if (entity_registry_get_instance()->storage == EntityStorage::Archetype)
+        {
+            entity_archetype_erase(entity, component_pool->type_index);
+        }
+        else
+        {
+            pool_delete_data(&component_pool->data_pool, entity);
+        }
+        
+        EntitySignature& signature = entity_registry_get_instance()->signatures[entity_index(entity)];
+        signature.set(component_pool->type_index, false);
+        entity_signature_changed(entity, signature, component_pool->type_index);
     }
 
     template <typename T>
     T& entity_get(EntityID entity)
     {
-        NIT_CHECK_MSG(entity_valid(entity), "Invalid entity!");
-        ComponentPool* component_pool = entity_find_component_pool<T>();
-        NIT_CHECK_MSG(component_pool, "Invalid component type!");
-        return *pool_get_data<T>(&component_pool->data_pool, entity);
+        return *entity_get_ptr<T>(entity);
     }
     
     bool          entity_enabled(EntityID entity);
@@ -229,6 +492,7 @@ namespace nit
     UUID          entity_get_uuid(EntityID entity);
     void          entity_add_child(EntityID entity, EntityID child);
     void          entity_get_children(EntityID entity, Array<EntityID>& children);
+    void          entity_get_children(EntityID entity, ArenaArray<EntityID>& children); // Copy in an arena, see ArenaScope
     void          entity_set_parent(EntityID entity, EntityID parent);
     EntityID      entity_get_parent(EntityID entity);
     void          entity_remove_child(EntityID entity, EntityID child);
@@ -236,32 +500,106 @@ namespace nit
     struct EntityArray { EntityData* entities = nullptr; u32 count = 0; };
     
     EntityArray entity_get_alive_entities();
+
+    // Calls fn(EntityID) for every alive entity that is enabled along with its ancestors, in id order. Goes through
+    // the enabled bitsets a word at a time, so 64 disabled or dead entities get skipped at once.
+    template <typename F>
+    void entity_for_each_enabled(F&& fn)
+    {
+        const EntityRegistry* entity_registry = entity_registry_get_instance();
+        const u32 word_count = entity_bit_words(entity_registry->max_entities);
+
+        for (u32 word = 0; word < word_count; ++word)
+        {
+            u64 bits = entity_registry->enabled_bits[word] & entity_registry->global_enabled_bits[word];
+
+            while (bits)
+            {
+                const u32 index = word * 64 + (u32) std::countr_zero(bits);
+                bits &= bits - 1;
+                fn(entity_make_handle(index, entity_registry->generations[index] & ENTITY_GENERATION_MASK));
+            }
+        }
+    }
+    
+    // Read only access, does not stamp the component as changed
+    template <typename T>
+    const T& entity_get_const(EntityID entity)
+    {
+        NIT_CHECK_MSG(entity_valid(entity), "Invalid entity!");
+        ComponentPool* component_pool = entity_find_component_pool<T>();
+        NIT_CHECK_MSG(component_pool, "Invalid component type!");
+        
+        if (entity_registry_get_instance()->storage == EntityStorage::Archetype)
+        {
+            return *static_cast<T*>(entity_archetype_get(entity, component_pool->type_index));
+        }
+        
+        return *pool_get_data<T>(&component_pool->data_pool, entity);
+    }
     
     template <typename T>
     T* entity_get_ptr(EntityID entity)
+    {
+        entity_mark_changed<T>(entity);
+        return const_cast<T*>(&entity_get_const<T>(entity));
+    }
+
+    template <typename T>
+    void entity_mark_changed(EntityID entity)
+    {
+        NIT_CHECK_MSG(entity_valid(entity), "Invalid entity!");
+        ComponentPool* component_pool = entity_find_component_pool<T>();
+        NIT_CHECK_MSG(component_pool, "Invalid component type!");
+        component_change_tick(component_pool, entity) = entity_registry_get_instance()->change_tick;
+    }
+
+    template <typename T>
+    bool entity_changed(EntityID entity, u32 since_tick)
     {
         NIT_CHECK_MSG(entity_valid(entity), "Invalid entity!");
         ComponentPool* component_pool = entity_find_component_pool<T>();
         NIT_CHECK_MSG(component_pool, "Invalid component type!");
-        return pool_get_data<T>(&component_pool->data_pool, entity);
+        const u32 index = entity_index(entity);
+        const u32* page = component_pool->change_ticks[index / SparseSet::PAGE_SIZE];
+        return page && page[index % SparseSet::PAGE_SIZE] > since_tick;
     }
 
     template <typename T>
     bool entity_has(EntityID entity)
     {
         NIT_CHECK_MSG(entity_valid(entity), "Invalid entity!");
-        return pool_get_data<EntityData>(&entity_registry_get_instance()->entities, entity)->signature.test(entity_component_type_index<T>());
+        return entity_registry_get_instance()->signatures[entity_index(entity)].test(entity_component_type_index<T>());
     }
 
-    EntityGroup& entity_get_group(EntitySignature signature);
+    // Creates the group on demand if nobody created it, filling it with the entities that already match. The reference
+    // is valid until the next entity_collect_groups. Concurrent systems can get existing groups, a group they miss gets
+    // created when their batch ends and they get an empty one until then, so the groups they use should be created up
+    // front with entity_create_group.
+    EntityGroup& entity_get_group(const EntitySignature& signature);
+
+    // Called by engine_broadcast_concurrent around the systems that run at the same time. Nothing inserts into the
+    // groups while they run, the end creates the groups they asked for.
+    void entity_begin_concurrent_systems();
+    void entity_end_concurrent_systems();
 
     template <typename... T>
     EntityGroup& entity_get_group()
     {
-        Array<u64> type_hashes = {get_type_hash<T>()...};
-        return entity_get_group(entity_build_signature(type_hashes));
+        if (((component_type_index<T> == 0) || ...))
+        {
+            static EntityGroup empty_group;
+            return empty_group;
+        }
+        
+        return entity_get_group(entity_build_signature<T...>());
     }
 
+    // Destroys the on demand groups that were not requested during the last group_gc_frames frames, once per frame
+    void entity_collect_groups();
+
+    // Groups created here are kept until the registry finishes. They can be created at any time, the entities that
+    // already match get added to it.
     EntitySignature entity_create_group(const Array<u64>& type_hashes);
 
     template <typename... T>
@@ -0,0 +1,343 @@
+#include "entity_commands.h"
+#include "archetype.h"
+#include "nit/core/job_system.h"
+
+namespace nit
+{
+    static void buffer_load(EntityCommandBuffer* buffer, u32 index)
+    {
+        buffer->index   = index;
+        buffer->adds    = new EntityCommandAdds[NIT_MAX_COMPONENT_TYPES];
+        buffer->removes = new Array<EntityID>[NIT_MAX_COMPONENT_TYPES];
+    }
+
+    static void buffer_free(EntityCommandBuffer* buffer)
+    {
+        EntityRegistry* entity_registry = entity_registry_get_instance();
+
+        for (u32 i = 0; i < NIT_MAX_COMPONENT_TYPES; ++i)
+        {
+            if (buffer->adds[i].data)
+            {
+                delete_array(entity_registry->component_pool[i].data_pool.type, buffer->adds[i].data);
+            }
+        }
+
+        delete[] buffer->adds;
+        delete[] buffer->removes;
+        *buffer = {};
+    }
+
+    static void buffer_clear(EntityCommandBuffer* buffer)
+    {
+        const u32 type_count = entity_registry_get_instance()->next_component_type_index - 1;
+        buffer->creates.clear();
+        buffer->created.clear();
+        buffer->destroys.clear();
+
+        // Keeps the component arrays around, the same buffer is going to record the same kind of commands next time
+        for (u32 i = 0; i < type_count; ++i)
+        {
+            buffer->adds[i].entities.clear();
+            buffer->removes[i].clear();
+        }
+    }
+
+    void entity_commands_init()
+    {
+        EntityRegistry* entity_registry = entity_registry_get_instance();
+        NIT_CHECK_MSG(!entity_registry->command_buffers[0], "Entity commands already initialized!");
+        const u32 count = job_thread_count();
+        NIT_CHECK_MSG(count <= (ENTITY_PENDING_BIT >> ENTITY_PENDING_SHIFT), "Too many threads for the entity command buffers!");
+        entity_registry->command_buffer_count = count;
+        entity_registry->recording_buffers    = 0;
+
+        for (EntityCommandBuffer*& buffers : entity_registry->command_buffers)
+        {
+            buffers = new EntityCommandBuffer[count];
+
+            for (u32 i = 0; i < count; ++i)
+            {
+                buffer_load(&buffers[i], i);
+            }
+        }
+    }
+
+    void entity_commands_finish()
+    {
+        EntityRegistry* entity_registry = entity_registry_get_instance();
+
+        for (EntityCommandBuffer*& buffers : entity_registry->command_buffers)
+        {
+            if (!buffers)
+            {
+                continue;
+            }
+
+            for (u32 i = 0; i < entity_registry->command_buffer_count; ++i)
+            {
+                buffer_free(&buffers[i]);
+            }
+
+            delete[] buffers;
+            buffers = nullptr;
+        }
+
+        entity_registry->command_buffer_count = 0;
+    }
+
+    EntityCommandBuffer* entity_commands()
+    {
+        EntityRegistry* entity_registry = entity_registry_get_instance();
+        const u32 thread_index = job_thread_index();
+        NIT_CHECK_MSG(thread_index < entity_registry->command_buffer_count, "Entity commands are not initialized!");
+        return &entity_registry->command_buffers[entity_registry->recording_buffers][thread_index];
+    }
+
+    EntityID entity_commands_create(EntityCommandBuffer* buffer, const String& name)
+    {
+        NIT_CHECK(buffer);
+        NIT_CHECK_MSG(buffer->creates.size() <= ENTITY_PENDING_MASK, "Too many pending entities!");
+        const EntityID pending = ENTITY_PENDING_BIT | (buffer->index << ENTITY_PENDING_SHIFT) | (u32) buffer->creates.size();
+        buffer->creates.push_back(name);
+        return pending;
+    }
+
+    void entity_commands_destroy(EntityCommandBuffer* buffer, EntityID entity)
+    {
+        NIT_CHECK(buffer);
+        buffer->destroys.push_back(entity);
+    }
+
+    void entity_commands_add_raw(EntityCommandBuffer* buffer, EntityID entity, u32 type_index, void* data)
+    {
+        NIT_CHECK(buffer && type_index != 0);
+        EntityCommandAdds& adds = buffer->adds[type_index - 1];
+        const Type* type = entity_registry_get_instance()->component_pool[type_index - 1].data_pool.type;
+        const u32 count = (u32) adds.entities.size();
+
+        if (count == adds.capacity)
+        {
+            const u32 new_capacity = std::max(adds.capacity * 2, 8u);
+            adds.data     = adds.data ? resize_array(type, adds.data, adds.capacity, new_capacity, MemoryTag::Entity) : new_array(type, new_capacity, MemoryTag::Entity);
+            adds.capacity = new_capacity;
+        }
+
+        set_array_raw_data(type, adds.data, count, data);
+        adds.entities.push_back(entity);
+    }
+
+    void entity_commands_remove_raw(EntityCommandBuffer* buffer, EntityID entity, u32 type_index)
+    {
+        NIT_CHECK(buffer && type_index != 0);
+        buffer->removes[type_index - 1].push_back(entity);
+    }
+
+    // Pending ids are resolved against the buffers being played back, the ones that recorded them
+    static EntityID resolve(EntityCommandBuffer* buffers, EntityID entity)
+    {
+        if (!entity_is_pending(entity))
+        {
+            return entity_valid(entity) ? entity : NULL_ENTITY;
+        }
+
+        const EntityCommandBuffer& buffer = buffers[(entity & ~ENTITY_PENDING_BIT) >> ENTITY_PENDING_SHIFT];
+        const u32 index = entity & ENTITY_PENDING_MASK;
+        return index < buffer.created.size() && entity_valid(buffer.created[index]) ? buffer.created[index] : NULL_ENTITY;
+    }
+
+    void entity_commands_playback()
+    {
+        NIT_PROFILE_FUNCTION();
+        EntityRegistry* entity_registry = entity_registry_get_instance();
+        NIT_CHECK_MSG(job_thread_index() == 0, "Entity commands can only be played back from the main thread!");
+
+        // Swap the sets so the commands recorded by the listeners of the playback are kept for the next one
+        EntityCommandBuffer* buffers = entity_registry->command_buffers[entity_registry->recording_buffers];
+        const u32 buffer_count       = entity_registry->command_buffer_count;
+        const u32 type_count         = entity_registry->next_component_type_index - 1;
+        const bool use_archetypes    = entity_registry->storage == EntityStorage::Archetype;
+        entity_registry->recording_buffers ^= 1;
+
+        // Adds applied to the storage, broadcast once every entity sits in its final archetype
+        struct AppliedAdd
+        {
+            EntityID entity    = NULL_ENTITY;
+            u32      type      = 0;
+            u32      buffer    = 0;
+            u32      index     = 0;
+            bool     added_new = false; // False when it overwrote a component the entity had
+        };
+
+        static Array<EntityID>   modified;
+        static Array<AppliedAdd> applied_adds;
+        modified.clear();
+        applied_adds.clear();
+
+        for (u32 b = 0; b < buffer_count; ++b)
+        {
+            EntityCommandBuffer& buffer = buffers[b];
+            buffer.created.resize(buffer.creates.size());
+
+            for (u32 i = 0; i < buffer.creates.size(); ++i)
+            {
+                buffer.created[i] = entity_create(buffer.creates[i]);
+            }
+        }
+
+        for (u32 type = 0; type < type_count; ++type)
+        {
+            ComponentPool& component_pool = entity_registry->component_pool[type];
+            const u32 type_index = type + 1;
+
+            for (u32 b = 0; b < buffer_count; ++b)
+            {
+                for (EntityID entity : buffers[b].removes[type])
+                {
+                    entity = resolve(buffers, entity);
+
+                    if (entity == NULL_ENTITY)
+                    {
+                        continue;
+                    }
+
+                    EntitySignature& signature = entity_registry->signatures[entity_index(entity)];
+
+                    if (!signature.test(type_index))
+                    {
+                        continue;
+                    }
+
+                    component_broadcast_removed(&component_pool, entity);
+
+                    if (!use_archetypes)
+                    {
+                        pool_delete_data(&component_pool.data_pool, entity);
+                    }
+
+                    signature.set(type_index, false);
+                    modified.push_back(entity);
+                }
+            }
+        }
+
+        for (u32 type = 0; type < type_count; ++type)
+        {
+            ComponentPool& component_pool = entity_registry->component_pool[type];
+            const u32 type_index = type + 1;
+
+#ifdef NIT_ENABLE_CHECKS
+            // The removals already ran, an add and a remove of the same component on one entity can't keep its order
+            static Array<EntityID> removed;
+            removed.clear();
+
+            for (u32 b = 0; b < buffer_count; ++b)
+            {
+                for (EntityID entity : buffers[b].removes[type])
+                {
+                    removed.push_back(resolve(buffers, entity));
+                }
+            }
+
+            std::sort(removed.begin(), removed.end());
+#endif
+
+            for (u32 b = 0; b < buffer_count; ++b)
+            {
+                EntityCommandAdds& adds = buffers[b].adds[type];
+
+                for (u32 i = 0; i < adds.entities.size(); ++i)
+                {
+                    const EntityID entity = resolve(buffers, adds.entities[i]);
+
+                    if (entity == NULL_ENTITY)
+                    {
+                        continue;
+                    }
+
+#ifdef NIT_ENABLE_CHECKS
+                    NIT_CHECK_MSG(!std::binary_search(removed.begin(), removed.end(), entity), "Component added and removed in the same playback!");
+#endif
+
+                    EntitySignature& signature = entity_registry->signatures[entity_index(entity)];
+                    void* data = get_array_raw_data(component_pool.data_pool.type, adds.data, i);
+                    const bool existed = signature.test(type_index);
+                    applied_adds.push_back({ entity, type, b, i, !existed });
+
+                    // With archetypes the data gets written once the entity sits in its final archetype
+                    if (!use_archetypes)
+                    {
+                        if (existed)
+                        {
+                            set_array_raw_data(component_pool.data_pool.type, pool_get_raw_data(&component_pool.data_pool, entity), 0, data);
+                        }
+                        else
+                        {
+                            pool_insert_data_with_id(&component_pool.data_pool, entity, data);
+                        }
+                    }
+
+                    component_change_tick(&component_pool, entity) = entity_registry->change_tick;
+                    signature.set(type_index, true);
+                    modified.push_back(entity);
+                }
+            }
+        }
+
+        std::sort(modified.begin(), modified.end());
+        modified.erase(std::unique(modified.begin(), modified.end()), modified.end());
+
+        for (EntityID entity : modified)
+        {
+            const EntitySignature& signature = entity_registry->signatures[entity_index(entity)];
+
+            if (use_archetypes)
+            {
+                archetype_move_entity(entity_registry->archetype_storage, entity, signature);
+            }
+
+            entity_signature_changed(entity, signature);
+        }
+
+        for (const AppliedAdd& add : applied_adds)
+        {
+            // The listeners of the previous adds could have destroyed the entity or removed the component
+            if (!entity_valid(add.entity) || !entity_registry->signatures[entity_index(add.entity)].test(add.type + 1))
+            {
+                continue;
+            }
+
+            ComponentPool& component_pool = entity_registry->component_pool[add.type];
+
+            if (use_archetypes)
+            {
+                void* data = get_array_raw_data(component_pool.data_pool.type, buffers[add.buffer].adds[add.type].data, add.index);
+                archetype_set_raw_data(entity_registry->archetype_storage, add.entity, add.type + 1, data);
+            }
+
+            // Overwriting a component the entity already had is not an addition
+            if (add.added_new)
+            {
+                component_broadcast_added(&component_pool, add.entity);
+            }
+        }
+
+        for (u32 b = 0; b < buffer_count; ++b)
+        {
+            for (EntityID entity : buffers[b].destroys)
+            {
+                entity = resolve(buffers, entity);
+
+                if (entity != NULL_ENTITY)
+                {
+                    entity_destroy(entity);
+                }
+            }
+        }
+
+        for (u32 b = 0; b < buffer_count; ++b)
+        {
+            buffer_clear(&buffers[b]);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+#include "entity.h"
+
+namespace nit
+{
+    // Entities created through a command buffer get a pending id that is only valid inside the command buffers until
+    // the playback creates the real entity. Bits 24..30 hold the buffer that created it and bits 0..23 its index.
+    inline constexpr u32 ENTITY_PENDING_BIT   = 1u << 31;
+    inline constexpr u32 ENTITY_PENDING_SHIFT = 24;
+    inline constexpr u32 ENTITY_PENDING_MASK  = (1u << ENTITY_PENDING_SHIFT) - 1;
+
+    // Components of one type waiting to be added, data is a type erased array that follows the order of entities
+    struct EntityCommandAdds
+    {
+        Array<EntityID> entities;
+        void*           data     = nullptr;
+        u32             capacity = 0;
+    };
+
+    // Records entity creations, destructions and component additions / removals to apply them later in one pass,
+    // so systems can spawn and destroy while they iterate a group or a view. Every job thread records into its own
+    // buffer (entity_commands) without locking. The engine plays them back after Start, FixedUpdate, Update and
+    // LateUpdate. The playback creates the entities first, then applies the removals and the additions grouped by
+    // component type, updating the groups once per modified entity, and destroys the entities last. The recorded order
+    // is not kept: every removal runs before every addition, so recording an add and a remove of the same component
+    // for the same entity before one playback is an error and asserts. Adding a component that the entity already has
+    // overwrites it without broadcasting the addition again, commands on dead entities are ignored.
+    struct EntityCommandBuffer
+    {
+        u32                index   = 0;
+        Array<String>      creates;            // Name of each pending entity
+        Array<EntityID>    created;            // Pending index -> entity, filled by the playback
+        Array<EntityID>    destroys;
+        EntityCommandAdds* adds    = nullptr;  // One per component type
+        Array<EntityID>*   removes = nullptr;  // One per component type
+    };
+
+    void                 entity_commands_init();
+    void                 entity_commands_finish();
+    EntityCommandBuffer* entity_commands();
+    EntityID             entity_commands_create(EntityCommandBuffer* buffer, const String& name = "");
+    void                 entity_commands_destroy(EntityCommandBuffer* buffer, EntityID entity);
+    void                 entity_commands_add_raw(EntityCommandBuffer* buffer, EntityID entity, u32 type_index, void* data);
+    void                 entity_commands_remove_raw(EntityCommandBuffer* buffer, EntityID entity, u32 type_index);
+    void                 entity_commands_playback();
+    
+    inline bool entity_is_pending(EntityID entity) { return entity != NULL_ENTITY && (entity & ENTITY_PENDING_BIT) != 0; }
+
+    template<typename T>
+    void entity_commands_add(EntityCommandBuffer* buffer, EntityID entity, const T& data = {})
+    {
+        entity_commands_add_raw(buffer, entity, entity_component_type_index<T>(), (void*) &data);
+    }
+
+    template<typename T>
+    void entity_commands_remove(EntityCommandBuffer* buffer, EntityID entity)
+    {
+        entity_commands_remove_raw(buffer, entity, entity_component_type_index<T>());
+    }
+}
\ No newline at end of file
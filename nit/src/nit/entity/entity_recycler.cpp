@@ -0,0 +1,173 @@
+#include "entity_recycler.h"
+#include "entity_commands.h"
+
+#include "render/transform.h"
+
+namespace nit
+{
+    using RecyclerClock = std::chrono::steady_clock;
+
+    static u64 elapsed_ns(RecyclerClock::time_point start)
+    {
+        return (u64) std::chrono::duration_cast<std::chrono::nanoseconds>(RecyclerClock::now() - start).count();
+    }
+
+    // Writes the prefab data back to the components of a parked entity. Components with an fn_on_recycle (the physics
+    // ones) keep their handles, so the body and the shapes get reused.
+    static void reset_components(const Prefab* prefab, EntityID entity)
+    {
+        EntityRegistry* entity_registry = entity_registry_get_instance();
+
+        for (u32 t = 0; t < prefab->type_indices.size(); ++t)
+        {
+            ComponentPool& component_pool = entity_registry->component_pool[prefab->type_indices[t] - 1];
+            const Type* type = component_pool.data_pool.type;
+
+            if (!entity_registry->signatures[entity_index(entity)].test(component_pool.type_index))
+            {
+                continue;
+            }
+
+            void* component = delegate_invoke(component_pool.fn_get_from_entity, entity);
+
+            if (!delegate_empty(component_pool.fn_on_recycle))
+            {
+                delegate_invoke(component_pool.fn_on_recycle, component, (const void*) prefab->data[t]);
+            }
+            else
+            {
+                set_array_raw_data(type, component, 0, prefab->data[t]);
+            }
+        }
+    }
+
+    static void park(EntityRecycler* recycler, EntityID entity)
+    {
+        entity_set_enabled(entity, false);
+        recycler->parked.push_back(entity);
+        recycler->stats.peak_parked = std::max(recycler->stats.peak_parked, (u32) recycler->parked.size());
+    }
+
+    void entity_recycler_load(EntityRecycler* recycler, const Prefab* prefab, u32 warm_up_count, u32 max_parked)
+    {
+        NIT_CHECK(recycler && prefab);
+        NIT_CHECK_MSG(!recycler->prefab, "Entity recycler already loaded!");
+        recycler->prefab     = prefab;
+        recycler->max_parked = max_parked;
+        recycler->stats      = {};
+        entity_recycler_warm_up(recycler, warm_up_count);
+    }
+
+    void entity_recycler_free(EntityRecycler* recycler)
+    {
+        NIT_CHECK(recycler);
+
+        for (EntityID entity : recycler->parked)
+        {
+            if (entity_valid(entity))
+            {
+                entity_destroy(entity);
+            }
+        }
+
+        *recycler = {};
+    }
+
+    void entity_recycler_warm_up(EntityRecycler* recycler, u32 count)
+    {
+        NIT_CHECK(recycler && recycler->prefab);
+        count = std::min(count, recycler->max_parked - std::min(recycler->max_parked, (u32) recycler->parked.size()));
+
+        if (count == 0)
+        {
+            return;
+        }
+
+        Array<EntityID> instances(count);
+        count = prefab_instantiate(recycler->prefab, count, instances.data());
+        recycler->parked.reserve(recycler->parked.size() + count);
+
+        for (u32 i = 0; i < count; ++i)
+        {
+            park(recycler, instances[i]);
+        }
+    }
+
+    EntityID entity_recycler_acquire(EntityRecycler* recycler, const Vector3& position)
+    {
+        NIT_CHECK(recycler && recycler->prefab);
+        const RecyclerClock::time_point start = RecyclerClock::now();
+        ++recycler->stats.acquires;
+
+        EntityID entity = NULL_ENTITY;
+
+        while (!recycler->parked.empty() && entity == NULL_ENTITY)
+        {
+            entity = recycler->parked.back();
+            recycler->parked.pop_back();
+
+            // Something else could have destroyed it while it was parked
+            if (!entity_valid(entity))
+            {
+                entity = NULL_ENTITY;
+            }
+        }
+
+        if (entity != NULL_ENTITY)
+        {
+            ++recycler->stats.hits;
+            reset_components(recycler->prefab, entity);
+
+            if (entity_has<Transform>(entity))
+            {
+                entity_get<Transform>(entity).position = position;
+            }
+
+            entity_set_enabled(entity, recycler->prefab->enabled);
+        }
+        else
+        {
+            ++recycler->stats.misses;
+            entity = prefab_instantiate(recycler->prefab, position);
+        }
+
+        const u64 ns = elapsed_ns(start);
+        recycler->stats.acquire_ns    += ns;
+        recycler->stats.max_acquire_ns = std::max(recycler->stats.max_acquire_ns, ns);
+        return entity;
+    }
+
+    void entity_recycler_release(EntityRecycler* recycler, EntityID entity)
+    {
+        NIT_CHECK(recycler);
+        NIT_CHECK_MSG(entity_valid(entity), "Invalid entity!");
+        const RecyclerClock::time_point start = RecyclerClock::now();
+        ++recycler->stats.releases;
+
+        if (recycler->parked.size() < recycler->max_parked)
+        {
+            park(recycler, entity);
+        }
+        else
+        {
+            // Deferred, so systems can release the entities of the view they are iterating
+            ++recycler->stats.destroys;
+            entity_set_enabled(entity, false);
+            entity_commands_destroy(entity_commands(), entity);
+        }
+
+        recycler->stats.release_ns += elapsed_ns(start);
+    }
+
+    f64 entity_recycler_hit_rate(const EntityRecycler* recycler)
+    {
+        NIT_CHECK(recycler);
+        return recycler->stats.acquires != 0 ? (f64) recycler->stats.hits / (f64) recycler->stats.acquires : 0.0;
+    }
+
+    f64 entity_recycler_average_acquire_us(const EntityRecycler* recycler)
+    {
+        NIT_CHECK(recycler);
+        return recycler->stats.acquires != 0 ? (f64) recycler->stats.acquire_ns / (f64) recycler->stats.acquires / 1000.0 : 0.0;
+    }
+}
\ No newline at end of file
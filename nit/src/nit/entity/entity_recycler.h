@@ -0,0 +1,40 @@
+#pragma once
+#include "prefab.h"
+
+namespace nit
+{
+    struct EntityRecyclerStats
+    {
+        u64 acquires       = 0;
+        u64 hits           = 0; // Acquires served by a parked instance
+        u64 misses         = 0; // Acquires that had to instantiate the prefab
+        u64 releases       = 0;
+        u64 destroys       = 0; // Releases that found the recycler full
+        u64 acquire_ns     = 0; // Accumulated time spent in entity_recycler_acquire
+        u64 release_ns     = 0; // Accumulated time spent in entity_recycler_release
+        u64 max_acquire_ns = 0;
+        u32 peak_parked    = 0;
+    };
+
+    // Keeps the released instances of a prefab parked as disabled entities and hands them back on acquire, so
+    // high churn objects (bullets, missiles...) skip the entity creation, the component inserts and the physics body
+    // and shape creation. Parked entities keep their components and their Box2D bodies, which stay disabled while
+    // the entity is (see physics_2d). Acquiring resets the components of the prefab to its data, through
+    // ComponentPool::fn_on_recycle for the ones that keep handles. Components added after the instantiation are kept. Releases beyond max_parked disable the entity and
+    // destroy it through entity_commands, so a system can release entities while it iterates them.
+    struct EntityRecycler
+    {
+        const Prefab*       prefab     = nullptr;
+        Array<EntityID>     parked     = {};
+        u32                 max_parked = U32_MAX;
+        EntityRecyclerStats stats      = {};
+    };
+
+    void     entity_recycler_load(EntityRecycler* recycler, const Prefab* prefab, u32 warm_up_count = 0, u32 max_parked = U32_MAX);
+    void     entity_recycler_free(EntityRecycler* recycler);
+    void     entity_recycler_warm_up(EntityRecycler* recycler, u32 count);
+    EntityID entity_recycler_acquire(EntityRecycler* recycler, const Vector3& position = V3_ZERO);
+    void     entity_recycler_release(EntityRecycler* recycler, EntityID entity);
+    f64      entity_recycler_hit_rate(const EntityRecycler* recycler);
+    f64      entity_recycler_average_acquire_us(const EntityRecycler* recycler);
+}
\ No newline at end of file
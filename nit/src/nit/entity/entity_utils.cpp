@@ -68,7 +68,7 @@ namespace nit
     {
         auto& camera_group = entity_get_group<Camera, Transform>();
         
-        if (camera_group.entities.empty())
+        if (camera_group.entities.count == 0)
         {
             return NULL_ENTITY;
         }
@@ -88,7 +88,7 @@ namespace nit
         return engine_get_instance()->editor.editor_camera_entity;
         
 #else
-        return *camera_group.entities.begin();
+        return camera_group.entities.dense[0];
 #endif
     }
 }
@@ -0,0 +1,258 @@
+#pragma once
+#include "entity.h"
+#include "archetype.h"
+#include "nit/core/job_system.h"
+
+namespace nit
+{
+    // Iterates the entities that have all the components T... yielding (EntityID, T&...) tuples:
+    //
+    //     for (auto [entity, transform, rb] : entity_view<Transform, Rigidbody2D>(true)) { ... }
+    //
+    // The component pools are resolved once when the view is created and the iteration is driven by the smallest
+    // one, so there is no per access validation or pool lookup. With archetype storage it walks the matching
+    // archetypes instead. Structural changes (entity_add / entity_remove / entity_destroy) are not allowed while
+    // iterating. Components requested as const are not stamped as changed (see entity_changed).
+    template<typename... T>
+    struct EntityView
+    {
+        static constexpr u32 COMPONENT_COUNT = sizeof...(T);
+
+        using Tuple = std::tuple<EntityID, T&...>;
+
+        Pool*             pools[COMPONENT_COUNT] = {};
+        u32**             change_ticks[COMPONENT_COUNT] = {};
+        u32               change_tick            = 0;
+        Pool*             driver                 = nullptr;
+        const u64*        enabled_bits           = nullptr;
+        const u64*        global_enabled_bits    = nullptr;
+        ArchetypeStorage* archetype_storage      = nullptr;
+        EntitySignature   signature;
+        bool              skip_disabled          = false;
+        bool              empty                  = false;
+
+        struct Iterator
+        {
+            const EntityView* view  = nullptr;
+            u32               outer = 0; // Archetype index, only used with archetype storage
+            u32               inner = 0; // Dense index in the driver pool or row in the archetype
+
+            bool operator==(const Iterator& other) const { return outer == other.outer && inner == other.inner; }
+            bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+            Iterator& operator++()
+            {
+                ++inner;
+                settle();
+                return *this;
+            }
+
+            Tuple operator*() const
+            {
+                return deref(std::index_sequence_for<T...>{});
+            }
+
+            EntityID entity() const
+            {
+                if (view->archetype_storage)
+                {
+                    Archetype* archetype = view->archetype_storage->archetypes[outer];
+                    return archetype_row_entity(archetype, inner);
+                }
+
+                return view->driver->sparse_set.dense[inner];
+            }
+
+            bool accepts(EntityID entity) const
+            {
+                if (view->skip_disabled && (!entity_bit_test(view->enabled_bits, entity) || !entity_bit_test(view->global_enabled_bits, entity)))
+                {
+                    return false;
+                }
+
+                if (view->archetype_storage)
+                {
+                    return true;
+                }
+
+                for (Pool* pool : view->pools)
+                {
+                    if (pool != view->driver && sparse_get(pool->sparse_set, entity) == SparseSet::INVALID)
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            // Moves forward until the iterator points to an accepted entity or to the end
+            void settle()
+            {
+                if (view->archetype_storage)
+                {
+                    const Array<Archetype*>& archetypes = view->archetype_storage->archetypes;
+
+                    while (outer < archetypes.size())
+                    {
+                        const Archetype* archetype = archetypes[outer];
+
+                        if (entity_signature_contains(archetype->signature, view->signature))
+                        {
+                            for (; inner < archetype->count; ++inner)
+                            {
+                                if (accepts(archetype_row_entity(archetype, inner)))
+                                {
+                                    return;
+                                }
+                            }
+                        }
+
+                        ++outer;
+                        inner = 0;
+                    }
+                    return;
+                }
+
+                for (; inner < view->driver->sparse_set.count; ++inner)
+                {
+                    if (accepts(view->driver->sparse_set.dense[inner]))
+                    {
+                        return;
+                    }
+                }
+            }
+
+            template<size_t... I>
+            Tuple deref(std::index_sequence<I...>) const
+            {
+                const EntityID current = entity();
+                const u32      index   = entity_index(current);
+                constexpr bool read_only[] = { std::is_const_v<T>... };
+
+                for (u32 i = 0; i < COMPONENT_COUNT; ++i)
+                {
+                    if (!read_only[i])
+                    {
+                        // The page exists, entity_add stamps the tick when the component is added
+                        view->change_ticks[i][index / SparseSet::PAGE_SIZE][index % SparseSet::PAGE_SIZE] = view->change_tick;
+                    }
+                }
+
+                if (view->archetype_storage)
+                {
+                    Archetype* archetype = view->archetype_storage->archetypes[outer];
+                    return Tuple { current, archetype_row_data<T>(archetype, archetype->columns[component_type_index<std::remove_const_t<T>>], inner)... };
+                }
+
+                return Tuple { current, *pool_get_data_at<std::remove_const_t<T>>(view->pools[I], sparse_get(view->pools[I]->sparse_set, current))... };
+            }
+        };
+
+        Iterator begin() const
+        {
+            Iterator it { this, 0, 0 };
+
+            if (empty)
+            {
+                return end();
+            }
+
+            it.settle();
+            return it;
+        }
+
+        Iterator end() const
+        {
+            if (empty)
+            {
+                return { this, 0, 0 };
+            }
+
+            if (archetype_storage)
+            {
+                return { this, (u32) archetype_storage->archetypes.size(), 0 };
+            }
+
+            return { this, 0, driver->sparse_set.count };
+        }
+    };
+
+    template<typename... T>
+    EntityView<T...> entity_view(bool skip_disabled = false)
+    {
+        static_assert(sizeof...(T) > 0, "Views need at least one component!");
+
+        EntityRegistry* entity_registry = entity_registry_get_instance();
+        EntityView<T...> view;
+        view.enabled_bits        = entity_registry->enabled_bits;
+        view.global_enabled_bits = entity_registry->global_enabled_bits;
+        view.skip_disabled     = skip_disabled;
+        view.signature         = entity_build_signature<std::remove_const_t<T>...>();
+        view.archetype_storage = entity_registry->archetype_storage;
+        view.change_tick       = entity_registry->change_tick;
+
+        const u32 type_indices[] = { component_type_index<std::remove_const_t<T>>... };
+
+        for (u32 i = 0; i < EntityView<T...>::COMPONENT_COUNT; ++i)
+        {
+            if (type_indices[i] == 0)
+            {
+                NIT_CHECK_MSG(false, "Component type is not registered!");
+                view.empty = true;
+                return view;
+            }
+
+            ComponentPool& component_pool = entity_registry->component_pool[type_indices[i] - 1];
+            Pool* pool = &component_pool.data_pool;
+            view.pools[i]        = pool;
+            view.change_ticks[i] = component_pool.change_ticks;
+
+            if (!view.archetype_storage && (!view.driver || pool->sparse_set.count < view.driver->sparse_set.count))
+            {
+                view.driver = pool;
+            }
+        }
+
+        return view;
+    }
+
+    // Calls fn(EntityID, T&...) for every entity of the view, splitting the work in batches across the job system.
+    // fn runs concurrently so it should only touch the components of the entity it receives.
+    template<typename... T, typename F>
+    void parallel_for(const EntityView<T...>& view, u32 batch_size, F&& fn)
+    {
+        using Iterator = typename EntityView<T...>::Iterator;
+
+        if (view.empty)
+        {
+            return;
+        }
+
+        auto visit = [&](u32 outer, u32 inner)
+        {
+            Iterator it { &view, outer, inner };
+
+            if (it.accepts(it.entity()))
+            {
+                std::apply(fn, *it);
+            }
+        };
+
+        if (view.archetype_storage)
+        {
+            const Array<Archetype*>& archetypes = view.archetype_storage->archetypes;
+
+            for (u32 outer = 0; outer < archetypes.size(); ++outer)
+            {
+                if (entity_signature_contains(archetypes[outer]->signature, view.signature))
+                {
+                    parallel_for(archetypes[outer]->count, batch_size, [&](u32 row) { visit(outer, row); });
+                }
+            }
+            return;
+        }
+
+        parallel_for(view.driver->sparse_set.count, batch_size, [&](u32 index) { visit(0, index); });
+    }
+}
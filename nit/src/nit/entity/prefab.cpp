@@ -0,0 +1,186 @@
+#include "prefab.h"
+#include "archetype.h"
+
+#include "render/transform.h"
+
+namespace nit
+{
+    template<typename T>
+    static bool prefab_has(const Prefab* prefab)
+    {
+        return component_type_index<T> != 0 && prefab->signature.test(component_type_index<T>);
+    }
+
+    void prefab_load(Prefab* prefab, EntityID source)
+    {
+        NIT_CHECK(prefab);
+        EntityRegistry* entity_registry = entity_registry_get_instance();
+        NIT_CHECK_MSG(entity_valid(source), "Invalid entity!");
+        prefab_free(prefab);
+
+        prefab->name      = String(entity_get_name(source)).append(" (clone)");
+        prefab->signature = entity_registry->signatures[entity_index(source)];
+        prefab->enabled   = entity_enabled(source);
+
+        for (u32 i = 0; i < entity_registry->next_component_type_index - 1; ++i)
+        {
+            ComponentPool& component_pool = entity_registry->component_pool[i];
+
+            if (!prefab->signature.test(component_pool.type_index))
+            {
+                continue;
+            }
+
+            void* data = new_array(component_pool.data_pool.type, 1, MemoryTag::Entity);
+            set_array_raw_data(component_pool.data_pool.type, data, 0, const_cast<void*>(delegate_invoke(component_pool.fn_get_const_from_entity, source)));
+
+            // Handles to objects owned by a system (bodies, shapes...) would be shared by every instance
+            if (!delegate_empty(component_pool.fn_on_prefab_copy))
+            {
+                delegate_invoke(component_pool.fn_on_prefab_copy, data);
+            }
+
+            prefab->type_indices.push_back(component_pool.type_index);
+            prefab->data.push_back(data);
+        }
+    }
+
+    void prefab_free(Prefab* prefab)
+    {
+        NIT_CHECK(prefab);
+        EntityRegistry* entity_registry = entity_registry_get_instance();
+
+        for (u32 i = 0; i < prefab->type_indices.size(); ++i)
+        {
+            delete_array(entity_registry->component_pool[prefab->type_indices[i] - 1].data_pool.type, prefab->data[i]);
+        }
+
+        *prefab = {};
+    }
+
+    void* prefab_get_raw_data(Prefab* prefab, u32 type_index)
+    {
+        NIT_CHECK(prefab);
+
+        for (u32 i = 0; i < prefab->type_indices.size(); ++i)
+        {
+            if (prefab->type_indices[i] == type_index)
+            {
+                return prefab->data[i];
+            }
+        }
+
+        NIT_CHECK_MSG(false, "Component is not part of the prefab!");
+        return nullptr;
+    }
+
+    u32 prefab_instantiate(const Prefab* prefab, u32 count, EntityID* out_entities, const Vector3* positions)
+    {
+        NIT_CHECK(prefab);
+        EntityRegistry* entity_registry = entity_registry_get_instance();
+        const bool use_archetypes = entity_registry->storage == EntityStorage::Archetype;
+
+        count = std::min(count, entity_registry->max_entities - entity_registry->entity_count);
+
+        if (count == 0)
+        {
+            NIT_CHECK_MSG(false, "Entity limit reached!");
+            return 0;
+        }
+
+        Array<EntityID> instances(count);
+
+        pool_reserve(&entity_registry->entities, entity_registry->entities.sparse_set.count + count);
+
+        for (u32 i = 0; i < count; ++i)
+        {
+            const EntityID entity = entity_create(prefab->name);
+            entity_registry->signatures[entity_index(entity)] = prefab->signature;
+            entity_bit_set(entity_registry->enabled_bits, entity, prefab->enabled);
+            entity_bit_set(entity_registry->global_enabled_bits, entity, prefab->enabled);
+            instances[i] = entity;
+
+            if (use_archetypes)
+            {
+                archetype_move_entity(entity_registry->archetype_storage, entity, prefab->signature);
+            }
+        }
+
+        for (u32 t = 0; t < prefab->type_indices.size(); ++t)
+        {
+            ComponentPool& component_pool = entity_registry->component_pool[prefab->type_indices[t] - 1];
+            void* data = prefab->data[t];
+
+            if (!use_archetypes)
+            {
+                pool_reserve(&component_pool.data_pool, component_pool.data_pool.sparse_set.count + count);
+            }
+
+            for (EntityID entity : instances)
+            {
+                if (use_archetypes)
+                {
+                    archetype_set_raw_data(entity_registry->archetype_storage, entity, component_pool.type_index, data);
+                }
+                else
+                {
+                    pool_insert_data_with_id(&component_pool.data_pool, entity, data);
+                }
+
+                component_change_tick(&component_pool, entity) = entity_registry->change_tick;
+            }
+        }
+
+        if (positions && prefab_has<Transform>(prefab))
+        {
+            for (u32 i = 0; i < count; ++i)
+            {
+                entity_get<Transform>(instances[i]).position = positions[i];
+            }
+        }
+
+        // The instances share the signature, so the membership is decided once per group
+        for (EntityGroup* group : entity_registry->groups_by_component[0])
+        {
+            if (!entity_signature_contains(prefab->signature, group->signature))
+            {
+                continue;
+            }
+
+            sparse_reserve(&group->entities, group->entities.count + count);
+
+            for (EntityID entity : instances)
+            {
+                sparse_insert(&group->entities, entity);
+            }
+        }
+
+        if (out_entities)
+        {
+            std::copy_n(instances.begin(), count, out_entities);
+        }
+
+        for (u32 type_index : prefab->type_indices)
+        {
+            ComponentPool* component_pool = &entity_registry->component_pool[type_index - 1];
+
+            for (EntityID entity : instances)
+            {
+                // Listeners of the previous types could have removed the component
+                if (entity_valid(entity) && entity_registry->signatures[entity_index(entity)].test(type_index))
+                {
+                    component_broadcast_added(component_pool, entity);
+                }
+            }
+        }
+
+        return count;
+    }
+
+    EntityID prefab_instantiate(const Prefab* prefab, const Vector3& position)
+    {
+        EntityID entity = NULL_ENTITY;
+        prefab_instantiate(prefab, 1, &entity, &position);
+        return entity;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+#include "entity.h"
+
+namespace nit
+{
+    // Components of an entity compiled once into a flat list of types plus their default data, so spawning does not
+    // have to ask every registered pool whether the source entity has the component (see entity_clone).
+    // prefab_instantiate creates N entities in one call: the pools get reserved once per type, trivially copyable
+    // components are copied with memcpy, the signature is assigned once per entity, every matching group gets
+    // reserved and filled once and the added events are broadcast at the end, grouped by type.
+    // Children of the source entity are not part of the prefab.
+    struct Prefab
+    {
+        String          name;              // Given to the instances
+        EntitySignature signature;
+        bool            enabled      = true;
+        Array<u32>      type_indices = {}; // Component types, in registration order
+        Array<void*>    data         = {}; // One element array per type holding the default data
+    };
+
+    void  prefab_load(Prefab* prefab, EntityID source);
+    void  prefab_free(Prefab* prefab);
+    void* prefab_get_raw_data(Prefab* prefab, u32 type_index);
+
+    // Creates count entities and writes them to out_entities (optional). positions (optional, count elements)
+    // overrides the Transform position of each instance. Returns the number of created entities.
+    u32      prefab_instantiate(const Prefab* prefab, u32 count, EntityID* out_entities = nullptr, const Vector3* positions = nullptr);
+    EntityID prefab_instantiate(const Prefab* prefab, const Vector3& position);
+
+    template<typename T>
+    T* prefab_get(Prefab* prefab)
+    {
+        return static_cast<T*>(prefab_get_raw_data(prefab, entity_component_type_index<T>()));
+    }
+}
\ No newline at end of file
@@ -80,6 +80,7 @@ namespace nit
     void scene_load_entities(Scene* scene)
     {
         NIT_CHECK(scene);
+        NIT_PROFILE_SCOPE("Scene Load");
         const YAML::Node node = YAML::Load(scene->cached_scene);
         const YAML::Node& entities_node = node["Entities"];
 
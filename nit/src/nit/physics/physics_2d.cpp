@@ -8,7 +8,9 @@
 #include "trigger_events.h"
 #include "box2d/box2d.h"
 #include "core/engine.h"
+#include "core/job_system.h"
 #include "entity/entity_utils.h"
+#include "entity/entity_view.h"
 #include "render/transform.h"
 
 namespace nit
@@ -96,8 +98,76 @@ namespace nit
     static ListenerAction start();
     static ListenerAction fixed_update();
     static ListenerAction end();
-    static ListenerAction on_component_added(const ComponentAddedArgs& args);
-    static ListenerAction on_component_removed(const ComponentRemovedArgs& args);
+    static ListenerAction on_rigidbody_added(const ComponentAddedArgs& args);
+    static ListenerAction on_box_collider_added(const ComponentAddedArgs& args);
+    static ListenerAction on_circle_collider_added(const ComponentAddedArgs& args);
+    static ListenerAction on_rigidbody_removed(const ComponentRemovedArgs& args);
+    static ListenerAction on_box_collider_removed(const ComponentRemovedArgs& args);
+    static ListenerAction on_circle_collider_removed(const ComponentRemovedArgs& args);
+    
+    // Prefab copies drop the handles, the instances get their own bodies and shapes when the components get added
+    static void on_rigidbody_prefab_copy(void* data)
+    {
+        Rigidbody2D* rb = static_cast<Rigidbody2D*>(data);
+        rb->invalidated = false;
+        rb->handle      = {};
+    }
+
+    static void on_box_collider_prefab_copy(void* data)
+    {
+        BoxCollider2D* collider = static_cast<BoxCollider2D*>(data);
+        collider->invalidated = false;
+        collider->handle      = {};
+    }
+
+    static void on_circle_collider_prefab_copy(void* data)
+    {
+        CircleCollider* collider = static_cast<CircleCollider*>(data);
+        collider->invalidated = false;
+        collider->handle      = {};
+    }
+
+    // Recycled entities keep their body and shapes, only the settings come from the prefab
+    static void on_rigidbody_recycle(void* component, const void* prefab_data)
+    {
+        Rigidbody2D* rb = static_cast<Rigidbody2D*>(component);
+        const Rigidbody2D body_state = *rb;
+        *rb = *static_cast<const Rigidbody2D*>(prefab_data);
+        rb->handle       = body_state.handle;
+        rb->invalidated  = body_state.invalidated;
+        rb->body_enabled = body_state.body_enabled;
+        rb->body_gravity = body_state.body_gravity;
+    }
+
+    static void on_box_collider_recycle(void* component, const void* prefab_data)
+    {
+        BoxCollider2D* collider = static_cast<BoxCollider2D*>(component);
+        const ShapeHandle handle = collider->handle;
+        const bool invalidated   = collider->invalidated;
+        *collider = *static_cast<const BoxCollider2D*>(prefab_data);
+        collider->handle      = handle;
+        collider->invalidated = invalidated;
+    }
+
+    static void on_circle_collider_recycle(void* component, const void* prefab_data)
+    {
+        CircleCollider* collider = static_cast<CircleCollider*>(component);
+        const ShapeHandle handle = collider->handle;
+        const bool invalidated   = collider->invalidated;
+        *collider = *static_cast<const CircleCollider*>(prefab_data);
+        collider->handle      = handle;
+        collider->invalidated = invalidated;
+    }
+
+    static void* box2d_alloc(unsigned int size, int alignment)
+    {
+        return memory_alloc(MemoryTag::Physics, size, (u64) alignment);
+    }
+
+    static void box2d_free(void* memory)
+    {
+        memory_free(memory);
+    }
     
     void physics_2d_init() 
     {
@@ -107,9 +177,12 @@ namespace nit
             physics_2d_set_instance(&instance);
         }
 
+        // Before any world gets created, Box2D memory is accounted to the physics tag
+        b2SetAllocator(box2d_alloc, box2d_free);
+
         u32 entity_count = entity_registry_get_instance()->max_entities;
 
-        physics_2d->all_entity_ids = new EntityID[entity_count];
+        physics_2d->all_entity_ids = memory_new_array<EntityID>(MemoryTag::Physics, entity_count);
 
         for (EntityID i = 0; i < entity_count; ++i)
         {
@@ -120,6 +193,13 @@ namespace nit
         entity_create_group<Transform, Rigidbody2D, BoxCollider2D>();
         entity_create_group<Transform, Rigidbody2D, CircleCollider>();
         entity_create_group<TriggerEvents>();
+
+        delegate_bind(entity_find_component_pool<Rigidbody2D>()->fn_on_prefab_copy, on_rigidbody_prefab_copy);
+        delegate_bind(entity_find_component_pool<BoxCollider2D>()->fn_on_prefab_copy, on_box_collider_prefab_copy);
+        delegate_bind(entity_find_component_pool<CircleCollider>()->fn_on_prefab_copy, on_circle_collider_prefab_copy);
+        delegate_bind(entity_find_component_pool<Rigidbody2D>()->fn_on_recycle, on_rigidbody_recycle);
+        delegate_bind(entity_find_component_pool<BoxCollider2D>()->fn_on_recycle, on_box_collider_recycle);
+        delegate_bind(entity_find_component_pool<CircleCollider>()->fn_on_recycle, on_circle_collider_recycle);
         
         engine_event(Stage::Start)       += EngineListener::create(start);
         engine_event(Stage::FixedUpdate) += EngineListener::create(fixed_update);
@@ -165,6 +245,110 @@ namespace nit
         }
     }
 
+    // Wraps a Box2D parallel for, its batches run as jobs and finish_task waits for them
+    struct PhysicsTask
+    {
+        b2TaskCallback* task    = nullptr;
+        void*           context = nullptr;
+        JobCounter      counter;
+    };
+
+    static constexpr u32 MAX_PHYSICS_TASKS   = 128;
+    static constexpr u32 MAX_PHYSICS_WORKERS = 64; // b2_maxWorkers, Box2D clamps the workerCount of the world to it
+
+    static PhysicsTask physics_tasks[MAX_PHYSICS_TASKS];
+    static u32         physics_task_count = 0;
+
+    // Box2D indexes its per worker data with the worker index it passes to the tasks, which has to be below the
+    // workerCount of the world and different for every task running at the same time. Any job system thread can
+    // pick up a batch, so the batches take the lowest free index when they start instead of the thread index.
+    static std::atomic<u64> physics_busy_workers  = 0;
+    static u32              physics_world_workers = 1; // workerCount of the current world, see world()
+
+    u32 physics_2d_worker_count()
+    {
+        if (!physics_2d_has_instance())
+        {
+            NIT_CHECK(false);
+            return 1;
+        }
+
+        return std::clamp(physics_2d->worker_count, 1u, std::min(job_thread_count(), MAX_PHYSICS_WORKERS));
+    }
+
+    static u32 physics_worker_acquire()
+    {
+        const u64 worker_mask = physics_world_workers == MAX_PHYSICS_WORKERS ? ~0ull : (1ull << physics_world_workers) - 1;
+        u64 busy = physics_busy_workers.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            if (const u64 free = ~busy & worker_mask; free != 0)
+            {
+                const u64 worker_bit = free & (~free + 1);
+
+                if (physics_busy_workers.compare_exchange_weak(busy, busy | worker_bit, std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    return (u32) std::countr_zero(worker_bit);
+                }
+
+                continue;
+            }
+
+            // Only tasks that don't wait on anything run alongside the solver, so one of them frees an index
+            std::this_thread::yield();
+            busy = physics_busy_workers.load(std::memory_order_relaxed);
+        }
+    }
+
+    static void physics_worker_release(u32 worker)
+    {
+        physics_busy_workers.fetch_and(~(1ull << worker), std::memory_order_release);
+    }
+
+    static void run_physics_task(void* data, u32 begin, u32 end)
+    {
+        PhysicsTask* physics_task = static_cast<PhysicsTask*>(data);
+        const u32 worker = physics_worker_acquire();
+        physics_task->task((i32) begin, (i32) end, worker, physics_task->context);
+        physics_worker_release(worker);
+    }
+
+    static void* enqueue_task(b2TaskCallback* task, i32 item_count, i32 min_range, void* task_context, void*)
+    {
+        NIT_CHECK_MSG(physics_world_workers <= job_thread_count(), "The job system has fewer threads than the physics world workers!");
+        const u32 worker_count = physics_world_workers;
+
+        if (worker_count <= 1 || physics_task_count == MAX_PHYSICS_TASKS)
+        {
+            const u32 worker = physics_worker_acquire();
+            task(0, item_count, worker, task_context);
+            physics_worker_release(worker);
+            return nullptr;
+        }
+
+        PhysicsTask* physics_task = &physics_tasks[physics_task_count++];
+        physics_task->task    = task;
+        physics_task->context = task_context;
+
+        // Single item tasks get a job each too, Box2D enqueues one b2SolverTask per worker and those spin waiting
+        // on each other, so each one has to be picked up by a different thread
+        const u32 count      = (u32) item_count;
+        const u32 batch_size = std::max((u32) min_range, (count + worker_count - 1) / worker_count);
+
+        for (u32 begin = 0; begin < count; begin += batch_size)
+        {
+            job_schedule({ run_physics_task, physics_task, begin, std::min(begin + batch_size, count), &physics_task->counter });
+        }
+
+        return physics_task;
+    }
+
+    static void finish_task(void* user_task, void*)
+    {
+        job_wait(&static_cast<PhysicsTask*>(user_task)->counter);
+    }
+
     static b2WorldId world()
     {
         if (!physics_2d_has_instance())
@@ -177,6 +361,13 @@ namespace nit
         {
             b2WorldDef def = b2DefaultWorldDef();
             def.gravity = to_box2d(physics_2d->gravity);
+            
+            // The solver tasks of every worker have to run at the same time, so there can't be more workers than
+            // job system threads. The world keeps the count it was created with.
+            physics_world_workers = physics_2d_worker_count();
+            def.workerCount = (i32) physics_world_workers;
+            def.enqueueTask = enqueue_task;
+            def.finishTask  = finish_task;
             physics_2d->world_handle = from_box2d(b2CreateWorld(&def));
             b2World_EnableSleeping(to_box2d(physics_2d->world_handle), false);
         }
@@ -184,7 +375,15 @@ namespace nit
         return to_box2d(physics_2d->world_handle);
     }
 
-    static void rigidbody_invalidate(Rigidbody2D& rb, const Vector2& position, f32 angle)
+    // Bodies and shapes point to the slot of the entity index, which holds the handle of its current owner
+    static void* entity_user_data(EntityID entity)
+    {
+        EntityID& slot = physics_2d->all_entity_ids[entity_index(entity)];
+        slot = entity;
+        return &slot;
+    }
+
+    static void rigidbody_invalidate(EntityID entity, Rigidbody2D& rb, const Vector2& position, f32 angle)
     {
         if (b2Body_IsValid(to_box2d(rb.handle)))
         {
@@ -198,8 +397,54 @@ namespace nit
         def.rotation     = b2MakeRot(angle);
         def.isAwake      = true;
         def.gravityScale = rb.gravity_scale;
+        def.userData     = entity_user_data(entity);
         
-        rb.handle      = from_box2d(b2CreateBody(world(), &def));
+        rb.handle       = from_box2d(b2CreateBody(world(), &def));
+        rb.body_enabled = true;
+        rb.body_gravity = rb.gravity_scale;
+    }
+
+    // Change tick at the end of the last fixed update, transforms stamped after it changed since the last step
+    static u32 last_step_tick = 0;
+    
+    // Pushes to the body the properties of the component that changed since the last sync. Disabled entities keep
+    // their body disabled instead of destroying it (see EntityRecycler)
+    static void rigidbody_sync(EntityID entity, const Transform& transform, const Rigidbody2D& rb)
+    {
+        auto body = to_box2d(rb.handle);
+        NIT_CHECK(b2Body_IsValid(body));
+
+        if (const bool enabled = rb.enabled && entity_global_enabled(entity); enabled != rb.body_enabled)
+        {
+            if (enabled)
+            {
+                // Transforms are not written back while the body is disabled, so the transform wins
+                b2Body_SetTransform(body, to_box2d((const Vector2&) transform.position), b2MakeRot(to_radians(transform.rotation.z)));
+                b2Body_Enable(body);
+            }
+            else
+            {
+                b2Body_Disable(body);
+            }
+            
+            entity_get<Rigidbody2D>(entity).body_enabled = enabled;
+        }
+
+        if (!rb.body_enabled)
+        {
+            return;
+        }
+
+        if (rb.gravity_scale != rb.body_gravity)
+        {
+            b2Body_SetGravityScale(body, rb.gravity_scale);
+            entity_get<Rigidbody2D>(entity).body_gravity = rb.gravity_scale;
+        }
+
+        if (rb.follow_transform && entity_changed<Transform>(entity, last_step_tick) && (entity_has<BoxCollider2D>(entity) || entity_has<CircleCollider>(entity)))
+        {
+            b2Body_SetTransform(body, to_box2d((const Vector2&) transform.position), b2MakeRot(to_radians(transform.rotation.z)));
+        }
     }
 
     static void shape_def_init(EntityID entity, b2ShapeDef& def, AssetHandle& material_handle, bool is_sensor)
@@ -244,7 +489,7 @@ namespace nit
         }
     }
     
-    static void box_collider_invalidate(EntityID entity, Rigidbody2D& rb, BoxCollider2D& collider)
+    static void box_collider_invalidate(EntityID entity, const Rigidbody2D& rb, BoxCollider2D& collider)
     {
         auto body = to_box2d(rb.handle);
         
@@ -265,11 +510,11 @@ namespace nit
         shape_def_init(entity, def, collider.physic_material, collider.is_trigger);
         b2Polygon poly = b2MakeBox(collider.size.x / 2.f, collider.size.y / 2.f);
         b2ShapeId shape_id = b2CreatePolygonShape(body, &def, &poly);
-        b2Shape_SetUserData(shape_id, &physics_2d->all_entity_ids[entity]);
+        b2Shape_SetUserData(shape_id, entity_user_data(entity));
         collider.handle = from_box2d(shape_id);
     }
     
-    static void circle_collider_invalidate(EntityID entity, Rigidbody2D& rb, CircleCollider& collider)
+    static void circle_collider_invalidate(EntityID entity, const Rigidbody2D& rb, CircleCollider& collider)
     {
         auto body = to_box2d(rb.handle);
         
@@ -294,20 +539,17 @@ namespace nit
         };
         
         b2ShapeId shape_id = b2CreateCircleShape(body, &def, &circle);
-        b2Shape_SetUserData(shape_id, &physics_2d->all_entity_ids[entity]);
+        b2Shape_SetUserData(shape_id, entity_user_data(entity));
         collider.handle = from_box2d(shape_id);
     }
 
-    static void physics_entity_invalidate(EntityID entity)
+    static void physics_entity_invalidate(EntityID entity, const Transform& transform, const Rigidbody2D& rb)
     {
-        auto& rb = entity_get<Rigidbody2D>(entity);
-
         if (!rb.invalidated)
         {
-            auto& transform = entity_get<Transform>(entity);
-                
-            rigidbody_invalidate(rb, (const Vector2&) transform.position, transform.rotation.z);
-            rb.invalidated = true;
+            Rigidbody2D& invalidated_rb = entity_get<Rigidbody2D>(entity);
+            rigidbody_invalidate(entity, invalidated_rb, (const Vector2&) transform.position, transform.rotation.z);
+            invalidated_rb.invalidated = true;
 
             if (entity_has<BoxCollider2D>(entity))
             {
@@ -323,80 +565,94 @@ namespace nit
     
     ListenerAction start()
     {
-        engine_get_instance()->entity_registry.component_added_event   += ComponentAddedListener::create(on_component_added);
-        engine_get_instance()->entity_registry.component_removed_event += ComponentRemovedListener::create(on_component_removed);
+        entity_on_add<Rigidbody2D>()       += ComponentAddedListener::create(on_rigidbody_added);
+        entity_on_add<BoxCollider2D>()     += ComponentAddedListener::create(on_box_collider_added);
+        entity_on_add<CircleCollider>()    += ComponentAddedListener::create(on_circle_collider_added);
+        entity_on_remove<Rigidbody2D>()    += ComponentRemovedListener::create(on_rigidbody_removed);
+        entity_on_remove<BoxCollider2D>()  += ComponentRemovedListener::create(on_box_collider_removed);
+        entity_on_remove<CircleCollider>() += ComponentRemovedListener::create(on_circle_collider_removed);
         
         return ListenerAction::StayListening;
     }
 
     ListenerAction end()
     {
-        engine_get_instance()->entity_registry.component_added_event   -= ComponentAddedListener::create(on_component_added);
-        engine_get_instance()->entity_registry.component_removed_event -= ComponentRemovedListener::create(on_component_removed);
+        entity_on_add<Rigidbody2D>()       -= ComponentAddedListener::create(on_rigidbody_added);
+        entity_on_add<BoxCollider2D>()     -= ComponentAddedListener::create(on_box_collider_added);
+        entity_on_add<CircleCollider>()    -= ComponentAddedListener::create(on_circle_collider_added);
+        entity_on_remove<Rigidbody2D>()    -= ComponentRemovedListener::create(on_rigidbody_removed);
+        entity_on_remove<BoxCollider2D>()  -= ComponentRemovedListener::create(on_box_collider_removed);
+        entity_on_remove<CircleCollider>() -= ComponentRemovedListener::create(on_circle_collider_removed);
         return ListenerAction::StayListening;
     }
 
-    ListenerAction on_component_added(const ComponentAddedArgs& args)
+    ListenerAction on_rigidbody_added(const ComponentAddedArgs& args)
     {
-        if (args.type == type_get<BoxCollider2D>() && entity_has<CircleCollider>(args.entity))
+        physics_entity_invalidate(args.entity, entity_get_const<Transform>(args.entity), entity_get_const<Rigidbody2D>(args.entity));
+        return ListenerAction::StayListening;
+    }
+
+    ListenerAction on_box_collider_added(const ComponentAddedArgs& args)
+    {
+        if (entity_has<CircleCollider>(args.entity))
         {
             entity_remove<CircleCollider>(args.entity); 
         }
-        else if (args.type == type_get<CircleCollider>() && entity_has<BoxCollider2D>(args.entity))
+        return ListenerAction::StayListening;
+    }
+
+    ListenerAction on_circle_collider_added(const ComponentAddedArgs& args)
+    {
+        if (entity_has<BoxCollider2D>(args.entity))
         {
             entity_remove<BoxCollider2D>(args.entity);
         }
+        return ListenerAction::StayListening;
+    }
 
-        if (args.type == type_get<Rigidbody2D>())
+    ListenerAction on_rigidbody_removed(const ComponentRemovedArgs& args)
+    {   
+        const auto& rb = entity_get_const<Rigidbody2D>(args.entity);
+        
+        if (b2Body_IsValid(to_box2d(rb.handle)))
         {
-            physics_entity_invalidate(args.entity);
+            b2DestroyBody(to_box2d(rb.handle));
         }
-        
         return ListenerAction::StayListening;
     }
 
-    ListenerAction on_component_removed(const ComponentRemovedArgs& args)
-    {   
-        if (args.type == type_get<Rigidbody2D>())
+    ListenerAction on_box_collider_removed(const ComponentRemovedArgs& args)
+    {
+        const auto& collider = entity_get_const<BoxCollider2D>(args.entity);
+        
+        if (entity_has<Rigidbody2D>(args.entity))
         {
-            auto& rb = entity_get<Rigidbody2D>(args.entity);
+            const auto& rb = entity_get_const<Rigidbody2D>(args.entity);
             
-            if (b2Body_IsValid(to_box2d(rb.handle)))
+            if (!b2Body_IsValid(to_box2d(rb.handle)) || !b2Shape_IsValid(to_box2d(collider.handle)))
             {
-                b2DestroyBody(to_box2d(rb.handle));
+                return ListenerAction::StayListening;
             }
-        }
-        else if (args.type == type_get<BoxCollider2D>())
-        {
-            auto& collider = entity_get<BoxCollider2D>(args.entity);
-            
-            if (entity_has<Rigidbody2D>(args.entity))
-            {
-                auto& rb = entity_get<Rigidbody2D>(args.entity);
-                
-                if (!b2Body_IsValid(to_box2d(rb.handle)) || !b2Shape_IsValid(to_box2d(collider.handle)))
-                {
-                    return ListenerAction::StayListening;
-                }
 
-                b2DestroyShape(to_box2d(collider.handle), true);
-            }
+            b2DestroyShape(to_box2d(collider.handle), true);
         }
-        else if (args.type == type_get<CircleCollider>())
+        return ListenerAction::StayListening;
+    }
+
+    ListenerAction on_circle_collider_removed(const ComponentRemovedArgs& args)
+    {
+        const auto& collider = entity_get_const<CircleCollider>(args.entity);
+        
+        if (entity_has<Rigidbody2D>(args.entity))
         {
-            auto& collider = entity_get<CircleCollider>(args.entity);
+            const auto& rb = entity_get_const<Rigidbody2D>(args.entity);
             
-            if (entity_has<Rigidbody2D>(args.entity))
+            if (!b2Body_IsValid(to_box2d(rb.handle)) || !b2Shape_IsValid(to_box2d(collider.handle)))
             {
-                auto& rb = entity_get<Rigidbody2D>(args.entity);
-                
-                if (!b2Body_IsValid(to_box2d(rb.handle)) || !b2Shape_IsValid(to_box2d(collider.handle)))
-                {
-                    return ListenerAction::StayListening;
-                }
-
-                b2DestroyShape(to_box2d(collider.handle), true);
+                return ListenerAction::StayListening;
             }
+
+            b2DestroyShape(to_box2d(collider.handle), true);
         }
         return ListenerAction::StayListening;
     }
@@ -407,65 +663,61 @@ namespace nit
 
         NIT_IF_EDITOR_ENABLED(if ((editor_get_instance()->is_paused && !editor_get_instance()->next_frame) || editor_get_instance()->is_stopped) return ListenerAction::StayListening;)
 
-        for (EntityID entity : entity_get_group<Transform, Rigidbody2D>().entities)
+        physics_2d_step();
+        return ListenerAction::StayListening;
+    }
+
+    void physics_2d_step()
+    {
+        if (!physics_2d_has_instance())
         {
-            if (!entity_global_enabled(entity))
-            {
-                continue;
-            }
-            
-            physics_entity_invalidate(entity);
+            NIT_CHECK(false);
+            return;
+        }
+
+        // Disabled entities are visited too so their bodies get disabled and parked entities get them created. The
+        // components are only taken as mutable when something changes, so they are not stamped every step.
+        for (auto [entity, transform, rb] : entity_view<const Transform, const Rigidbody2D>())
+        {
+            physics_entity_invalidate(entity, transform, rb);
+            rigidbody_sync(entity, transform, rb);
         }
         
-        for (EntityID entity : entity_get_group<Transform, Rigidbody2D, BoxCollider2D>().entities)
+        for (auto [entity, transform, rb, collider] : entity_view<const Transform, const Rigidbody2D, const BoxCollider2D>())
         {
-            if (!entity_global_enabled(entity))
-            {
-                continue;
-            }
-            
-            auto& collider = entity_get<BoxCollider2D>(entity);
-
             if (!collider.invalidated)
             {
-                auto& rb = entity_get<Rigidbody2D>(entity);
-                
-                box_collider_invalidate(entity, rb, collider);
-                collider.invalidated = true;
+                BoxCollider2D& box_collider = entity_get<BoxCollider2D>(entity);
+                box_collider_invalidate(entity, rb, box_collider);
+                box_collider.invalidated = true;
             }
         }
 
-        for (EntityID entity : entity_get_group<Transform, Rigidbody2D, CircleCollider>().entities)
+        for (auto [entity, transform, rb, collider] : entity_view<const Transform, const Rigidbody2D, const CircleCollider>())
         {
-            if (!entity_global_enabled(entity))
-            {
-                continue;
-            }
-            
-            auto& collider = entity_get<CircleCollider>(entity);
-
             if (!collider.invalidated)
             {
-                auto& rb= entity_get<Rigidbody2D>(entity);
-                
-                circle_collider_invalidate(entity, rb, collider);
-                collider.invalidated = true;
+                CircleCollider& circle_collider = entity_get<CircleCollider>(entity);
+                circle_collider_invalidate(entity, rb, circle_collider);
+                circle_collider.invalidated = true;
             }
         }
 
         b2World_SetGravity(world() , to_box2d(physics_2d->gravity));
-        b2World_Step(world(), fixed_delta_seconds(), physics_2d->sub_steps);
+        {
+            NIT_PROFILE_SCOPE("b2World_Step");
+            b2World_Step(world(), fixed_delta_seconds(), physics_2d->sub_steps);
+        }
+        physics_task_count = 0;
 
-        for (EntityID entity : entity_get_group<TriggerEvents>().entities)
+        for (auto [entity, events] : entity_view<const TriggerEvents>(true))
         {
-            if (!entity_global_enabled(entity))
+            if (!events.enter_events.empty() || !events.exit_events.empty())
             {
-                continue;
+                TriggerEvents& trigger_events = entity_get<TriggerEvents>(entity);
+                trigger_events.enter_events.clear();
+                trigger_events.exit_events.clear();
             }
-            
-            auto& events = entity_get<TriggerEvents>(entity);
-            events.enter_events.clear();
-            events.exit_events.clear();
         }
         
         b2SensorEvents sensor_events = b2World_GetSensorEvents(to_box2d(physics_2d->world_handle));
@@ -482,12 +734,12 @@ namespace nit
                 .visitor_entity = visitor_entity
             };
             
-            if (entity_has<TriggerEvents>(trigger_entity))
+            if (entity_valid(trigger_entity) && entity_has<TriggerEvents>(trigger_entity))
             {
                 entity_get<TriggerEvents>(trigger_entity).enter_events.emplace_back(enter_event);
             }
 
-            if (entity_has<TriggerEvents>(visitor_entity))
+            if (entity_valid(visitor_entity) && entity_has<TriggerEvents>(visitor_entity))
             {
                 entity_get<TriggerEvents>(visitor_entity).enter_events.emplace_back(enter_event);
             }
@@ -505,83 +757,62 @@ namespace nit
                 .visitor_entity = visitor_entity
             };
             
-            if (entity_has<TriggerEvents>(trigger_entity))
+            if (entity_valid(trigger_entity) && entity_has<TriggerEvents>(trigger_entity))
             {
                 entity_get<TriggerEvents>(trigger_entity).exit_events.emplace_back(exit_event);
             }
 
-            if (entity_has<TriggerEvents>(visitor_entity))
+            if (entity_valid(visitor_entity) && entity_has<TriggerEvents>(visitor_entity))
             {
                 entity_get<TriggerEvents>(visitor_entity).exit_events.emplace_back(exit_event);
             }
         }
         
-        for (EntityID entity : entity_get_group<Transform, Rigidbody2D>().entities)
+        // Only the bodies that moved during the step need their transform written back
+        b2BodyEvents body_events = b2World_GetBodyEvents(world());
+
+        for (i32 i = 0; i < body_events.moveCount; ++i)
         {
-            if (!entity_global_enabled(entity))
+            const b2BodyMoveEvent& move_event = body_events.moveEvents[i];
+
+            if (!move_event.userData)
             {
                 continue;
             }
-            
-            const bool has_box_collider    = entity_has<BoxCollider2D>(entity); 
-            const bool has_circle_collider = entity_has<CircleCollider>(entity); 
-            
-            if (!has_box_collider && !has_circle_collider)
+
+            EntityID entity = *(EntityID*) move_event.userData;
+
+            if (!entity_valid(entity) || !entity_global_enabled(entity) || !entity_has<Rigidbody2D>(entity) || !entity_has<Transform>(entity))
             {
                 continue;
             }
-            
-            auto& rb = entity_get<Rigidbody2D>(entity);
-            auto& transform = entity_get<Transform>(entity);  
-            
-            auto body = to_box2d(rb.handle);
-        
-            if (!b2Body_IsValid(body))
+
+            if (entity_get_const<Rigidbody2D>(entity).follow_transform)
             {
-                NIT_CHECK(false);
                 continue;
             }
 
-            if (rb.enabled && !b2Body_IsEnabled(body))
-            {
-                b2Body_Enable(body);
-            }
-            else if (!rb.enabled && b2Body_IsEnabled(body))
+            Vector2 center;
+
+            if (entity_has<BoxCollider2D>(entity))
             {
-                b2Body_Disable(body);
+                center = entity_get_const<BoxCollider2D>(entity).center;
             }
-
-            if (rb.follow_transform)
+            else if (entity_has<CircleCollider>(entity))
             {
-                b2Body_SetTransform(body, to_box2d((const Vector2&) transform.position), b2MakeRot(to_radians(transform.rotation.z)));
+                center = entity_get_const<CircleCollider>(entity).center;
             }
             else
             {
-                Vector2 center;
-                
-                if (has_box_collider)
-                {
-                    center = entity_get<BoxCollider2D>(entity).center;
-                }
-                else if (has_circle_collider)
-                {
-                    center = entity_get<CircleCollider>(entity).center;
-                }
-                else
-                {
-                    NIT_CHECK(false);
-                    continue;
-                }
-                
-                Vector2 body_pos = from_box2d(b2Body_GetPosition(body)) - center;
-                transform.position = { body_pos.x, body_pos.y, transform.position.z };
-                const auto rot = b2Body_GetRotation(body);
-                transform.rotation.z = to_degrees(atan2(rot.s, rot.c));
+                continue;
             }
 
-            b2Body_SetGravityScale(body, rb.gravity_scale);
+            auto& transform = entity_get<Transform>(entity);
+            Vector2 body_pos = from_box2d(move_event.transform.p) - center;
+            transform.position = { body_pos.x, body_pos.y, transform.position.z };
+            transform.rotation.z = to_degrees(atan2(move_event.transform.q.s, move_event.transform.q.c));
         }
-        
-        return ListenerAction::StayListening;
+
+        last_step_tick = entity_advance_change_tick();
     }
 }
\ No newline at end of file
@@ -30,7 +30,8 @@ namespace nit
         WorldHandle world_handle        = {};
         Vector2     gravity             = { 0.f, -9.8f };
         u32         sub_steps           = 6u;
-        EntityID*   all_entity_ids      = nullptr;
+        u32         worker_count        = U32_MAX; // Job system threads used to step the world, U32_MAX uses all of them (64 at most). Read when the world gets created
+        EntityID*   all_entity_ids      = nullptr; // Entity index -> handle, pointed by the user data of bodies and shapes
     };
 
     void       physics_2d_set_instance(Physics2D* instance);
@@ -38,6 +39,11 @@ namespace nit
     Physics2D* physics_2d_get_instance();
     void       physics_2d_init();
     void       physics_2d_finish();
+    u32        physics_2d_worker_count();
+
+    // Creates the bodies and shapes of new components, syncs the changed ones, steps the world and writes the moved
+    // bodies back to their transforms. Runs on FixedUpdate unless the editor is paused.
+    void       physics_2d_step();
 
     void rigidbody_add_force(Rigidbody2D& rb, const Vector2& force, const Vector2& point);
     void rigidbody_set_velocity(Rigidbody2D& rb, const Vector2& velocity);
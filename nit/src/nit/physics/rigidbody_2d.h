@@ -14,6 +14,8 @@ namespace nit
         bool       follow_transform = false;
         BodyHandle handle           = {};
         bool       invalidated      = false;
+        bool       body_enabled     = true; // Last values pushed to the body, used to push only the changes
+        float      body_gravity     = 0.f;
     };
     
     void register_rigidbody_2d_component();
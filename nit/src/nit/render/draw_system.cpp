@@ -8,6 +8,7 @@
 #include "entity/entity_utils.h"
 #include "nit/core/engine.h"
 #include "nit/entity/entity.h"
+#include "nit/entity/entity_view.h"
 #include "nit/render/texture.h"
 #include "nit/render/font.h"
 #include "physics/box_collider_2d.h"
@@ -28,8 +29,10 @@ namespace nit
     ListenerAction draw();
     
     static ListenerAction on_asset_destroyed(const AssetDestroyedArgs& args);
-    static ListenerAction on_component_added(const ComponentAddedArgs& args);
-    static ListenerAction on_component_removed(const ComponentRemovedArgs& args);
+    static ListenerAction on_sprites_added(const EntityID* entities, u32 count);
+    static ListenerAction on_texts_added(const EntityID* entities, u32 count);
+    static ListenerAction on_sprite_removed(const ComponentRemovedArgs& args);
+    static ListenerAction on_text_removed(const ComponentRemovedArgs& args);
 
     void register_draw_system()
     {
@@ -38,6 +41,8 @@ namespace nit
         engine_event(Stage::Update) += EngineListener::create(update);
         engine_event(Stage::Draw)   += EngineListener::create(draw);
         
+        engine_system_access(EngineListener::create(update), {}, entity_build_signature<Sprite, FlipBookAnimation>());
+        
         entity_create_group<Sprite, Transform>();
         entity_create_group<Camera, Transform>();
         entity_create_group<Circle, Transform>();
@@ -49,30 +54,27 @@ namespace nit
     ListenerAction start()
     {
         engine_get_instance()->asset_registry.asset_destroyed_event    += AssetDestroyedListener::create(on_asset_destroyed);
-        engine_get_instance()->entity_registry.component_added_event   += ComponentAddedListener::create(on_component_added);
-        engine_get_instance()->entity_registry.component_removed_event += ComponentRemovedListener::create(on_component_removed);
+        entity_on_add_batch<Sprite>() += ComponentBatchListener::create(on_sprites_added);
+        entity_on_add_batch<Text>()   += ComponentBatchListener::create(on_texts_added);
+        entity_on_remove<Sprite>() += ComponentRemovedListener::create(on_sprite_removed);
+        entity_on_remove<Text>()   += ComponentRemovedListener::create(on_text_removed);
         return ListenerAction::StayListening;
     }
 
     ListenerAction end()
     {
         engine_get_instance()->asset_registry.asset_destroyed_event    -= AssetDestroyedListener::create(on_asset_destroyed);
-        engine_get_instance()->entity_registry.component_added_event   -= ComponentAddedListener::create(on_component_added);
-        engine_get_instance()->entity_registry.component_removed_event -= ComponentRemovedListener::create(on_component_removed);
+        entity_on_add_batch<Sprite>() -= ComponentBatchListener::create(on_sprites_added);
+        entity_on_add_batch<Text>()   -= ComponentBatchListener::create(on_texts_added);
+        entity_on_remove<Sprite>() -= ComponentRemovedListener::create(on_sprite_removed);
+        entity_on_remove<Text>()   -= ComponentRemovedListener::create(on_text_removed);
         return ListenerAction::StayListening;
     }
 
     ListenerAction update()
     {
-        for (EntityID entity : entity_get_group<Sprite, Transform, FlipBookAnimation>().entities)
+        for (auto [entity, sprite, animation] : entity_view<Sprite, FlipBookAnimation>(true))
         {
-            if (!entity_global_enabled(entity))
-            {
-                continue;
-            }
-            
-            auto& animation = entity_get<FlipBookAnimation>(entity);
-
             if (!asset_valid(animation.flipbook) || !animation.playing)
             {
                 continue;
@@ -91,7 +93,6 @@ namespace nit
 
             if (animation.time >= current_key.time)
             {
-                auto& sprite = entity_get<Sprite>(entity);
                 sprite.sub_texture = current_key.name;
                 sprite.sub_texture_index = current_key.index;
                 ++animation.current_key;
@@ -125,11 +126,15 @@ namespace nit
         return ListenerAction::StayListening;
     }
 
-    static ListenerAction on_component_added(const ComponentAddedArgs& args)
+    // Sprites added since the last flush. Consecutive sprites with the same texture and sub texture (instances of
+    // the same prefab, a loaded scene) reuse the sub texture lookup of the previous one.
+    static ListenerAction on_sprites_added(const EntityID* entities, u32 count)
     {
-        if (args.type == type_get<Sprite>())
+        const Sprite* previous = nullptr;
+        
+        for (u32 i = 0; i < count; ++i)
         {
-            auto& sprite = entity_get<Sprite>(args.entity); 
+            auto& sprite = entity_get<Sprite>(entities[i]); 
             auto& asset = sprite.texture;
 
             asset_retarget_handle(asset);
@@ -141,18 +146,31 @@ namespace nit
                 asset_retain(asset);
             }
 
-            if (is_valid)
+            if (!is_valid)
             {
-                sprite.sub_texture_index = texture_2d_get_sub_tex_index(asset_get_data<Texture2D>(asset), sprite.sub_texture);
+                sprite.sub_texture_index = -1;
+                continue;
+            }
+
+            if (previous && previous->texture.id == asset.id && previous->sub_texture == sprite.sub_texture)
+            {
+                sprite.sub_texture_index = previous->sub_texture_index;
             }
             else
             {
-                sprite.sub_texture_index = -1;
+                sprite.sub_texture_index = texture_2d_get_sub_tex_index(asset_get_data<Texture2D>(asset), sprite.sub_texture);
             }
+
+            previous = &sprite;
         }
-        else if (args.type == type_get<Text>())
+        return ListenerAction::StayListening;
+    }
+
+    static ListenerAction on_texts_added(const EntityID* entities, u32 count)
+    {
+        for (u32 i = 0; i < count; ++i)
         {
-            auto& asset = entity_get<Text>(args.entity).font;
+            auto& asset = entity_get<Text>(entities[i]).font;
             asset_retarget_handle(asset);
             if (asset_valid(asset) && !asset_loaded(asset))
             {
@@ -162,45 +180,46 @@ namespace nit
         return ListenerAction::StayListening;
     }
 
-    static ListenerAction on_component_removed(const ComponentRemovedArgs& args)
+    static ListenerAction on_sprite_removed(const ComponentRemovedArgs& args)
     {
-        if (args.type == type_get<Sprite>())
+        auto& sprite = entity_get<Sprite>(args.entity); 
+        auto& asset = sprite.texture;
+        asset_retarget_handle(asset);
+        
+        if (asset_valid(asset) && asset_loaded(asset))
         {
-            auto& sprite = entity_get<Sprite>(args.entity); 
-            auto& asset = sprite.texture;
-            asset_retarget_handle(asset);
-            
-            if (asset_valid(asset) && asset_loaded(asset))
-            {
-                asset_release(asset);
-            }
+            asset_release(asset);
         }
-        else if (args.type == type_get<Text>())
+        return ListenerAction::StayListening;
+    }
+
+    static ListenerAction on_text_removed(const ComponentRemovedArgs& args)
+    {
+        auto& asset = entity_get<Text>(args.entity).font;
+        asset_retarget_handle(asset);
+        if (asset_valid(asset) && asset_loaded(asset))
         {
-            auto& asset = entity_get<Text>(args.entity).font;
-            asset_retarget_handle(asset);
-            if (asset_valid(asset) && asset_loaded(asset))
-            {
-                asset_release(asset);
-            }
+            asset_release(asset);
         }
         return ListenerAction::StayListening;
     }
     
     ListenerAction draw()
     {
+        transform_update_global_transforms();
+        
         // Sprite sorting
 
         auto& sprite_group = entity_get_group<Sprite, Transform>().entities;
-        Array<EntityID> sorted_sprite_group(sprite_group.begin(), sprite_group.end());
+        ArenaArray<EntityID> sorted_sprite_group(begin(sprite_group), end(sprite_group), frame_arena());
         std::ranges::sort(sorted_sprite_group, [](EntityID a, EntityID b) ->bool {
-            return entity_get<Sprite>(a).draw_layer < entity_get<Sprite>(b).draw_layer; 
+            return entity_get_const<Sprite>(a).draw_layer < entity_get_const<Sprite>(b).draw_layer; 
         });
         
         Scene2D scene_2d
         {
-            .camera           = entity_get<Camera>(get_main_camera()),
-            .camera_transform = entity_get<Transform>(get_main_camera()),
+            .camera           = entity_get_const<Camera>(get_main_camera()),
+            .camera_transform = entity_get_const<Transform>(get_main_camera()),
             .window_size      = engine_window_size()
         };
         
@@ -213,23 +232,24 @@ namespace nit
                     continue;
                 }
                 
-                auto& transform = entity_get<Transform>(entity);
-                auto& sprite = entity_get<Sprite>(entity);
+                // Read only, drawing must not mark the sprites as changed
+                const Sprite& sprite = entity_get_const<Sprite>(entity);
 
                 if (!sprite.visible || sprite.tint.w <= F32_EPSILON)
                 {
                     continue;
                 }
 
-                bool has_texture = asset_valid(sprite.texture); 
+                AssetHandle texture = sprite.texture;
+                bool has_texture = asset_valid(texture); 
 
-                Texture2D* texture_data = has_texture ? asset_get_data<Texture2D>(sprite.texture) : nullptr; 
+                Texture2D* texture_data = has_texture ? asset_get_data<Texture2D>(texture) : nullptr; 
                 
                 if (has_texture)
                 {
-                    if (!asset_loaded(sprite.texture))
+                    if (!asset_loaded(texture))
                     {
-                        asset_retain(sprite.texture);
+                        asset_retain(texture);
                     }
                     
                     Vector2 size = texture_data->size;
@@ -270,53 +290,39 @@ namespace nit
                         vertex_positions = DEFAULT_VERTEX_POSITIONS_2D;
                     }
                     
-                    transform_vertex_positions(vertex_positions, transform_to_matrix(transform, entity));
+                    transform_vertex_positions(vertex_positions, transform_get_global(entity).matrix);
                 }
                 else
                 {
                     vertex_positions = DEFAULT_VERTEX_POSITIONS_2D;
-                    transform_vertex_positions(vertex_positions, transform_to_matrix(transform, entity));
+                    transform_vertex_positions(vertex_positions, transform_get_global(entity).matrix);
                 }
                 
                 fill_vertex_colors(vertex_colors, sprite.tint);
                 draw_quad(texture_data, vertex_positions, vertex_uvs, vertex_colors, (i32) entity);
             }
 
-            for (EntityID entity : entity_get_group<Line2D, Transform>().entities)
+            for (auto [entity, line, transform] : entity_view<const Line2D, const Transform>(true))
             {
-                if (!entity_global_enabled(entity))
-                {
-                    continue;
-                }
-                
-                auto& transform = entity_get<Transform>(entity);
-                auto& line = entity_get<Line2D>(entity);
-
                 if (!line.visible || line.tint.w <= F32_EPSILON )
                 {
                     continue;
                 }
                 
                 fill_line_2d_vertex_positions(vertex_positions, line.start, line.end, line.thickness);
-                transform_vertex_positions(vertex_positions, transform_to_matrix(transform, entity));
+                transform_vertex_positions(vertex_positions, transform_get_global(entity).matrix);
                 fill_vertex_colors(vertex_colors, line.tint);
                 draw_line_2d(vertex_positions, vertex_colors, (i32) entity);
             }
             
-            for (EntityID entity : entity_get_group<Text, Transform>().entities)
+            for (auto [entity, text, transform] : entity_view<const Text, const Transform>(true))
             {
-                if (!entity_global_enabled(entity))
-                {
-                    continue;
-                }
-                
-                auto& transform = entity_get<Transform>(entity);
-                auto& text = entity_get<Text>(entity);
-                Font* font_data = asset_valid(text.font) ? asset_get_data<Font>(text.font) : nullptr;
+                AssetHandle font = text.font;
+                Font* font_data = asset_valid(font) ? asset_get_data<Font>(font) : nullptr;
 
-                if (font_data && !asset_loaded(text.font))
+                if (font_data && !asset_loaded(font))
                 {
-                    asset_retain(text.font);
+                    asset_retain(font);
                 }
                 
                 if (!text.visible || text.text.empty() || !font_data)
@@ -327,7 +333,7 @@ namespace nit
                 draw_text(
                       font_data
                     , text.text
-                    , transform_to_matrix(transform, entity)
+                    , transform_get_global(entity).matrix
                     , text.tint
                     , text.spacing
                     , text.size
@@ -335,23 +341,15 @@ namespace nit
                 );
             }
 
-            for (EntityID entity : entity_get_group<Circle, Transform>().entities)
+            for (auto [entity, circle, transform] : entity_view<const Circle, const Transform>(true))
             {
-                if (!entity_global_enabled(entity))
-                {
-                    continue;
-                }
-                
-                auto& transform = entity_get<Transform>(entity);
-                auto& circle = entity_get<Circle>(entity);
-
                 if (!circle.visible || circle.tint.w <= F32_EPSILON)
                 {
                     continue;
                 }
                 
                 fill_circle_vertex_positions(vertex_positions, circle.radius);
-                transform_vertex_positions(vertex_positions, transform_to_matrix(transform, entity));
+                transform_vertex_positions(vertex_positions, transform_get_global(entity).matrix);
                 fill_vertex_colors(vertex_colors, circle.tint);
                 draw_circle(vertex_positions, vertex_colors, circle.thickness, circle.fade, (i32) entity);
             }
@@ -360,15 +358,8 @@ namespace nit
 #ifdef NIT_EDITOR_ENABLED
             if (engine_get_instance()->editor.enabled)
             {
-                for (EntityID entity : entity_get_group<Transform, Rigidbody2D, BoxCollider2D>().entities)
+                for (auto [entity, transform, rb, collider] : entity_view<const Transform, const Rigidbody2D, const BoxCollider2D>(true))
                 {
-                    if (!entity_global_enabled(entity))
-                    {
-                        continue;
-                    }
-                    
-                    auto& transform  = entity_get<Transform>(entity);
-                    auto& collider   = entity_get<BoxCollider2D>(entity);
                     auto collider_color = collider.is_trigger ? V4_COLOR_CYAN : V4_COLOR_LIGHT_GREEN;
 
                     Vector3 position = transform.position + to_v3(collider.center); 
@@ -380,15 +371,8 @@ namespace nit
                     draw_line_2d(position, rotation, V3_ONE,  { -0.5f * collider.size.x,  0.5f * collider.size.y }, {-0.5f * collider.size.x, -0.5f * collider.size.y }, collider_color, 0.05f / 2.f, entity);
                 }
         
-                for (EntityID entity : entity_get_group<Transform, Rigidbody2D, CircleCollider>().entities)
+                for (auto [entity, transform, rb, collider] : entity_view<const Transform, const Rigidbody2D, const CircleCollider>(true))
                 {
-                    if (!entity_global_enabled(entity))
-                    {
-                        continue;
-                    }
-                    
-                    auto& transform  = entity_get<Transform>(entity);
-                    auto& collider   = entity_get<CircleCollider>(entity);
                     auto collider_color = collider.is_trigger ? V4_COLOR_CYAN : V4_COLOR_LIGHT_GREEN;
                     
                     draw_circle(
@@ -41,7 +41,7 @@ namespace nit
         file_stream.seekg(0, std::ifstream::end);
         const std::streamoff length = file_stream.tellg();
         file_stream.seekg(0, std::ifstream::beg);
-        const auto buffer = new char[length];
+        char* buffer = static_cast<char*>(memory_alloc(MemoryTag::Asset, length));
         file_stream.read(buffer, length);
         file_stream.close();
 
@@ -53,14 +53,15 @@ namespace nit
         static constexpr u32 CHAR_COUNT = 256;
 
         constexpr i32 pixels_alpha_lenght = HEIGHT * WIDTH;
-        const auto pixels_alpha = new unsigned char[pixels_alpha_lenght];
-        auto* baked_char = new stbtt_bakedchar[CHAR_COUNT];
+        auto* pixels_alpha = static_cast<unsigned char*>(memory_alloc(MemoryTag::Asset, pixels_alpha_lenght));
+        auto* baked_char   = memory_new_array<stbtt_bakedchar>(MemoryTag::Asset, CHAR_COUNT);
 
         stbtt_BakeFontBitmap(font_buffer, 0, PIXEL_HEIGHT, pixels_alpha, WIDTH, HEIGHT, 0, CHAR_COUNT, baked_char);
         font->baked_char_data = reinterpret_cast<void*>(baked_char);
 
         constexpr i32 pixels_rgb_lenght = pixels_alpha_lenght * 4;
-        const auto pixels_rgb = new unsigned char[pixels_rgb_lenght];
+        // Owned by the atlas, FreeTextureImage gives it back
+        auto* pixels_rgb = static_cast<unsigned char*>(memory_alloc(MemoryTag::Asset, pixels_rgb_lenght));
 
         i32 curr_index = 0;
         i32 pixels_index = 0;
@@ -84,16 +85,15 @@ namespace nit
         
         texture_2d_load(&font->atlas);
         
-        delete[] pixels_alpha;
-        delete[] buffer;
+        memory_free(pixels_alpha);
+        memory_free(buffer);
     }
 
     void font_free(Font* font)
     {
         if (font->baked_char_data)
         {
-            const auto* baked_char = static_cast<stbtt_bakedchar*>(font->baked_char_data);
-            delete[] baked_char;
+            memory_delete_array(static_cast<stbtt_bakedchar*>(font->baked_char_data));
             font->baked_char_data = nullptr;
         }
 
@@ -21,10 +21,21 @@ namespace nit
         im_gui_renderer = im_gui_renderer_instance;
     }
 
+    static void* imgui_alloc(size_t size, void*)
+    {
+        return memory_alloc(MemoryTag::Editor, size);
+    }
+
+    static void imgui_free(void* memory, void*)
+    {
+        memory_free(memory);
+    }
+
     void im_gui_init(void* window_handler)
     {
         NIT_CHECK_IM_GUI_CREATED
         IMGUI_CHECKVERSION();
+        ImGui::SetAllocatorFunctions(imgui_alloc, imgui_free);
         ImGui::CreateContext();
 
         ImGuiIO& io = ImGui::GetIO();
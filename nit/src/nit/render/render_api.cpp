@@ -169,6 +169,13 @@ namespace nit
         unbind_vertex_array();
     }
 
+    void draw_elements_base_vertex(u32 vao, u32 element_count, i32 base_vertex)
+    {
+        bind_vertex_array(vao);
+        glDrawElementsBaseVertex(GL_TRIANGLES, element_count, GL_UNSIGNED_INT, nullptr, base_vertex);
+        unbind_vertex_array();
+    }
+
     void draw_arrays(u32 vao, u32 element_count)
     {
         bind_vertex_array(vao);
@@ -187,5 +194,44 @@ namespace nit
             glDisable(GL_DEPTH_TEST);
         }
     }
+
+    void* create_fence()
+    {
+        return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    void wait_fence(void* fence)
+    {
+        if (!fence)
+        {
+            return;
+        }
+
+        GLbitfield flags   = 0;
+        GLuint64   timeout = 0;
+
+        while (true)
+        {
+            const GLenum result = glClientWaitSync(static_cast<GLsync>(fence), flags, timeout);
+
+            if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED)
+            {
+                NIT_CHECK_MSG(result != GL_WAIT_FAILED, "Failed waiting for GPU fence!");
+                return;
+            }
+
+            // First poll failed, flush the commands so the fence can be signaled and block from now on
+            flags   = GL_SYNC_FLUSH_COMMANDS_BIT;
+            timeout = 1000000; // 1 ms
+        }
+    }
+
+    void destroy_fence(void* fence)
+    {
+        if (fence)
+        {
+            glDeleteSync(static_cast<GLsync>(fence));
+        }
+    }
 }
 #endif
\ No newline at end of file
@@ -31,6 +31,12 @@ namespace nit
     void  set_blending_enabled(bool enabled);
     void  set_blending_mode(BlendingMode blending_mode);
     void  draw_elements(u32 vao, u32 element_count);
+    void  draw_elements_base_vertex(u32 vao, u32 element_count, i32 base_vertex);
     void  draw_arrays(u32 vao, u32 element_count);
     void  set_depth_test_enabled(bool enabled);
+    
+    // GPU fences, wait_fence blocks until all the commands issued before create_fence have been executed
+    void* create_fence();
+    void  wait_fence(void* fence);
+    void  destroy_fence(void* fence);
 }
\ No newline at end of file
@@ -34,6 +34,9 @@ namespace nit
             render_objects_set_instance(&render_objects_instance);
         }
         
+        render_objects->vertex_arrays.tag  = MemoryTag::Render;
+        render_objects->vertex_buffers.tag = MemoryTag::Render;
+        render_objects->index_buffers.tag  = MemoryTag::Render;
         pool_load<VertexArray> (&render_objects->vertex_arrays, 100);
         pool_load<VertexBuffer>(&render_objects->vertex_buffers, 100);
         pool_load<IndexBuffer> (&render_objects->index_buffers, 100);
@@ -55,11 +58,11 @@ namespace nit
         glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
 
-    void set_vertex_buffer_data(u32 vertex_buffer, const void* data, u64 size)
+    void set_vertex_buffer_data(u32 vertex_buffer, const void* data, u64 size, u64 offset)
     {
         auto* vertex_buffer_data = pool_get_data<VertexBuffer>(&render_objects->vertex_buffers, vertex_buffer);
         glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_data->buffer_id);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+        glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
     }
 
     u32 create_vertex_buffer(const void* vertices, u64 size)
@@ -84,9 +87,34 @@ namespace nit
         return id;
     }
 
+    u32 create_persistent_vertex_buffer(u64 size)
+    {
+        NIT_CHECK_RENDER_OBJECTS_CREATED
+        if (!GLAD_GL_VERSION_4_4)
+        {
+            return create_vertex_buffer(size);
+        }
+        
+        u32 id;
+        auto* vertex_buffer_data = pool_insert_data<VertexBuffer>(&render_objects->vertex_buffers, id);
+        constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glCreateBuffers(1, &vertex_buffer_data->buffer_id);
+        glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_data->buffer_id);
+        glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+        vertex_buffer_data->mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags);
+        NIT_CHECK_MSG(vertex_buffer_data->mapped, "Failed to map the persistent vertex buffer!");
+        return id;
+    }
+
     void destroy_vertex_buffer(u32 vertex_buffer)
     {
         auto* vertex_buffer_data = pool_get_data<VertexBuffer>(&render_objects->vertex_buffers, vertex_buffer);
+        if (vertex_buffer_data->mapped)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_data->buffer_id);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            vertex_buffer_data->mapped = nullptr;
+        }
         glDeleteBuffers(1, &vertex_buffer_data->buffer_id);
         pool_delete_data(&render_objects->vertex_buffers, vertex_buffer);
     }
@@ -66,14 +66,20 @@ namespace nit
     {
         u32 buffer_id;
         BufferLayout layout;
+        void* mapped = nullptr; // Only for persistent buffers, stays mapped until the buffer is destroyed
     };
 
     VertexBuffer& get_vertex_buffer_data(u32 vertex_buffer);
     void bind_vertex_buffer(u32 vertex_buffer);
     void unbind_vertex_buffer();
-    void set_vertex_buffer_data(u32 vertex_buffer, const void* data, u64 size);
+    void set_vertex_buffer_data(u32 vertex_buffer, const void* data, u64 size, u64 offset = 0);
     u32  create_vertex_buffer(const void* vertices, u64 size);
     u32  create_vertex_buffer(u64 size);
+    
+    // Immutable storage mapped once with persistent coherent write access, writes to VertexBuffer::mapped are visible
+    // to the GPU without any upload. Falls back to a regular dynamic buffer (mapped == nullptr) if buffer storage
+    // is not supported.
+    u32  create_persistent_vertex_buffer(u64 size);
     void destroy_vertex_buffer(u32 vertex_buffer);
     
     struct IndexBuffer
@@ -61,7 +61,7 @@ namespace nit
         {
             constexpr u32 max_indices = MAX_PRIMITIVES * INDICES_PER_PRIMITIVE;
 
-            const auto indices = new u32[max_indices];
+            u32* indices = static_cast<u32*>(memory_alloc(MemoryTag::Render, sizeof(u32) * max_indices));
 
             u32 offset = 0;
             for (u32 i = 0; i < max_indices; i += 6)
@@ -77,14 +77,14 @@ namespace nit
                 offset += 4;
             }
             renderer_2d->ibo = create_index_buffer(indices, max_indices);
-            delete[] indices;
+            memory_free(indices);
         }
 
         // QUAD VO
         {
-            constexpr u32 num_of_vertices = MAX_PRIMITIVES * VERTICES_PER_PRIMITIVE;
             renderer_2d->quad_vao = create_vertex_array();
-            renderer_2d->quad_vbo = create_vertex_buffer(num_of_vertices * sizeof(QuadVertex));
+            vertex_ring_load(&renderer_2d->quad_ring, PRIMITIVES_PER_RING_REGION * VERTICES_PER_PRIMITIVE * sizeof(QuadVertex));
+            renderer_2d->quad_vbo = renderer_2d->quad_ring.vertex_buffer;
             get_vertex_buffer_data(renderer_2d->quad_vbo).layout = {
                 {ShaderDataType::Float4, "a_Position"},
                 {ShaderDataType::Float4, "a_Tint"},
@@ -93,7 +93,6 @@ namespace nit
                 {ShaderDataType::Int, "a_EntityID"}
             };
             add_vertex_buffer(renderer_2d->quad_vao, renderer_2d->quad_vbo);
-            renderer_2d->quad_batch = new QuadVertex[num_of_vertices];
             add_index_buffer(renderer_2d->quad_vao, renderer_2d->ibo);
         }
 
@@ -104,7 +103,8 @@ namespace nit
             // White texture
             renderer_2d->white_texture.size       = V2_ONE;
             renderer_2d->white_texture.channels   = 4;
-            renderer_2d->white_texture.pixel_data = new u8[]{ 255, 255, 255, 255 };
+            renderer_2d->white_texture.pixel_data = static_cast<u8*>(memory_alloc(MemoryTag::Render, 4));
+            memset(renderer_2d->white_texture.pixel_data, 255, 4);
             texture_2d_load(&renderer_2d->white_texture);
             
             renderer_2d->textures_to_bind[0] = &renderer_2d->white_texture;
@@ -124,9 +124,9 @@ namespace nit
 
         // CIRCLE VO
         {
-            constexpr u32 num_of_vertices = MAX_PRIMITIVES * VERTICES_PER_PRIMITIVE;
             renderer_2d->circle_vao = create_vertex_array();
-            renderer_2d->circle_vbo = create_vertex_buffer(num_of_vertices * sizeof(CircleVertex));
+            vertex_ring_load(&renderer_2d->circle_ring, PRIMITIVES_PER_RING_REGION * VERTICES_PER_PRIMITIVE * sizeof(CircleVertex));
+            renderer_2d->circle_vbo = renderer_2d->circle_ring.vertex_buffer;
             get_vertex_buffer_data(renderer_2d->circle_vbo).layout = {
                 {ShaderDataType::Float4, "a_Position"},
                 {ShaderDataType::Float4, "a_LocalPosition"},
@@ -136,7 +136,6 @@ namespace nit
                 {ShaderDataType::Int, "a_EntityID"}
             };
             add_vertex_buffer(renderer_2d->circle_vao, renderer_2d->circle_vbo);
-            renderer_2d->circle_batch = new CircleVertex[num_of_vertices];
             add_index_buffer(renderer_2d->circle_vao, renderer_2d->ibo);
         }
 
@@ -149,16 +148,15 @@ namespace nit
 
         // LINE VO
         {
-            constexpr u32 num_of_vertices = MAX_PRIMITIVES * VERTICES_PER_PRIMITIVE;
             renderer_2d->line_vao = create_vertex_array();
-            renderer_2d->line_vbo = create_vertex_buffer(num_of_vertices * sizeof(LineVertex));
+            vertex_ring_load(&renderer_2d->line_ring, PRIMITIVES_PER_RING_REGION * VERTICES_PER_PRIMITIVE * sizeof(LineVertex));
+            renderer_2d->line_vbo = renderer_2d->line_ring.vertex_buffer;
             get_vertex_buffer_data(renderer_2d->line_vbo).layout = {
                 {ShaderDataType::Float4, "a_Position"},
                 {ShaderDataType::Float4, "a_Tint"},
                 {ShaderDataType::Int, "a_EntityID"}
             };
             add_vertex_buffer(renderer_2d->line_vao, renderer_2d->line_vbo);
-            renderer_2d->line_batch = new LineVertex[num_of_vertices];
             add_index_buffer(renderer_2d->line_vao, renderer_2d->ibo);
         }
 
@@ -171,9 +169,9 @@ namespace nit
 
         // CHAR VO
         {
-            constexpr u32 num_of_vertices = MAX_PRIMITIVES * VERTICES_PER_PRIMITIVE;
             renderer_2d->char_vao = create_vertex_array();
-            renderer_2d->char_vbo = create_vertex_buffer(num_of_vertices * sizeof(CharVertex));
+            vertex_ring_load(&renderer_2d->char_ring, PRIMITIVES_PER_RING_REGION * VERTICES_PER_PRIMITIVE * sizeof(CharVertex));
+            renderer_2d->char_vbo = renderer_2d->char_ring.vertex_buffer;
             get_vertex_buffer_data(renderer_2d->char_vbo).layout = {
                 {ShaderDataType::Float4, "a_Position"},
                 {ShaderDataType::Float4, "a_Tint"},
@@ -182,7 +180,6 @@ namespace nit
                 {ShaderDataType::Int, "a_EntityID"}
             };
             add_vertex_buffer(renderer_2d->char_vao, renderer_2d->char_vbo);
-            renderer_2d->char_batch = new CharVertex[num_of_vertices];
             add_index_buffer(renderer_2d->char_vao, renderer_2d->ibo);
         }
 
@@ -199,28 +196,38 @@ namespace nit
     void start_batch()
     {
         NIT_CHECK_RENDERER_2D_CREATED
+        renderer_2d->quad_batch = reinterpret_cast<QuadVertex*>(vertex_ring_head(&renderer_2d->quad_ring));
         renderer_2d->last_quad_vertex = renderer_2d->quad_batch;
         renderer_2d->quad_count = 0;
         renderer_2d->last_texture_slot = 1;
         renderer_2d->quad_index_count = 0;
 
+        renderer_2d->circle_batch = reinterpret_cast<CircleVertex*>(vertex_ring_head(&renderer_2d->circle_ring));
         renderer_2d->last_circle_vertex = renderer_2d->circle_batch;
         renderer_2d->circle_count = 0;
         renderer_2d->circle_index_count = 0;
 
+        renderer_2d->line_batch = reinterpret_cast<LineVertex*>(vertex_ring_head(&renderer_2d->line_ring));
         renderer_2d->last_line_vertex = renderer_2d->line_batch;
         renderer_2d->line_count = 0;
         renderer_2d->line_index_count = 0;
 
+        renderer_2d->char_batch = reinterpret_cast<CharVertex*>(vertex_ring_head(&renderer_2d->char_ring));
         renderer_2d->last_char_vertex = renderer_2d->char_batch;
         renderer_2d->char_count = 0;
         renderer_2d->char_index_count = 0;
     }
 
+    template<typename V>
+    static i32 batch_base_vertex(const VertexRing& ring, const V* batch)
+    {
+        return static_cast<i32>((reinterpret_cast<const u8*>(batch) - ring.mapped) / sizeof(V));
+    }
+
     void flush()
     {
         NIT_CHECK_RENDERER_2D_CREATED
-        //SCOPED_PROFILE(Render2D);
+        NIT_PROFILE_SCOPE("Renderer2D Flush");
 
         if (const u64 quad_vertex_data_size = (renderer_2d->last_quad_vertex - renderer_2d->quad_batch) * sizeof(QuadVertex))
         {
@@ -235,8 +242,8 @@ namespace nit
             renderer_2d->default_material->SetConstantMat4("u_ProjectionView", renderer_2d->projection_view);
             renderer_2d->default_material->SubmitConstants();
 
-            set_vertex_buffer_data(renderer_2d->quad_vbo, renderer_2d->quad_batch, quad_vertex_data_size);
-            draw_elements(renderer_2d->quad_vao, renderer_2d->quad_index_count);
+            vertex_ring_commit(&renderer_2d->quad_ring, quad_vertex_data_size);
+            draw_elements_base_vertex(renderer_2d->quad_vao, renderer_2d->quad_index_count, batch_base_vertex(renderer_2d->quad_ring, renderer_2d->quad_batch));
         }
 
         else if (const u64 circle_vertex_data_size = (renderer_2d->last_circle_vertex - renderer_2d->circle_batch) * sizeof(CircleVertex))
@@ -245,8 +252,8 @@ namespace nit
             renderer_2d->default_material->SetConstantMat4("u_ProjectionView", renderer_2d->projection_view);
             renderer_2d->default_material->SubmitConstants();
 
-            set_vertex_buffer_data(renderer_2d->circle_vbo, renderer_2d->circle_batch, circle_vertex_data_size);
-            draw_elements(renderer_2d->circle_vao, renderer_2d->circle_index_count);
+            vertex_ring_commit(&renderer_2d->circle_ring, circle_vertex_data_size);
+            draw_elements_base_vertex(renderer_2d->circle_vao, renderer_2d->circle_index_count, batch_base_vertex(renderer_2d->circle_ring, renderer_2d->circle_batch));
         }
 
         else if (const u64 line_vertex_data_size = (renderer_2d->last_line_vertex - renderer_2d->line_batch) * sizeof(LineVertex))
@@ -255,10 +262,10 @@ namespace nit
             renderer_2d->default_material->SetConstantMat4("u_ProjectionView", renderer_2d->projection_view);
             renderer_2d->default_material->SubmitConstants();
 
-            set_vertex_buffer_data(renderer_2d->line_vbo, renderer_2d->line_batch, line_vertex_data_size);
-            draw_elements(renderer_2d->line_vao, renderer_2d->line_index_count);
+            vertex_ring_commit(&renderer_2d->line_ring, line_vertex_data_size);
+            draw_elements_base_vertex(renderer_2d->line_vao, renderer_2d->line_index_count, batch_base_vertex(renderer_2d->line_ring, renderer_2d->line_batch));
         }
-        else if (const u64 char_vertex_data_size = (renderer_2d->last_char_vertex - renderer_2d->char_batch) * sizeof(QuadVertex))
+        else if (const u64 char_vertex_data_size = (renderer_2d->last_char_vertex - renderer_2d->char_batch) * sizeof(CharVertex))
         {
             NIT_CHECK(renderer_2d->default_material);
             for (u32 i = 0; i < renderer_2d->last_texture_slot; i++)
@@ -271,8 +278,28 @@ namespace nit
             renderer_2d->default_material->SetConstantMat4("u_ProjectionView", renderer_2d->projection_view);
             renderer_2d->default_material->SubmitConstants();
 
-            set_vertex_buffer_data(renderer_2d->char_vbo, renderer_2d->char_batch, char_vertex_data_size);
-            draw_elements(renderer_2d->char_vao, renderer_2d->char_index_count);
+            vertex_ring_commit(&renderer_2d->char_ring, char_vertex_data_size);
+            draw_elements_base_vertex(renderer_2d->char_vao, renderer_2d->char_index_count, batch_base_vertex(renderer_2d->char_ring, renderer_2d->char_batch));
+        }
+    }
+
+    // Flushes and jumps to the next ring region if the primitive does not fit after the ones already batched. The
+    // check is relative to the ring head so it still holds if the batch gets flushed before the primitive is written.
+    static void reserve_primitive(VertexRing* ring, u32 primitive_count, u64 vertex_size)
+    {
+        const u64 primitive_size = vertex_size * VERTICES_PER_PRIMITIVE;
+
+        if (primitive_count >= MAX_PRIMITIVES)
+        {
+            next_batch();
+            primitive_count = 0;
+        }
+
+        if (!vertex_ring_fits(ring, (primitive_count + 1) * primitive_size))
+        {
+            flush();
+            vertex_ring_next_region(ring);
+            start_batch();
         }
     }
 
@@ -408,10 +435,7 @@ namespace nit
     )
     {
         NIT_CHECK_RENDERER_2D_CREATED
-        if (renderer_2d->quad_count >= MAX_PRIMITIVES)
-        {
-            next_batch();
-        }
+        reserve_primitive(&renderer_2d->quad_ring, renderer_2d->quad_count, sizeof(QuadVertex));
 
         SetCurrentShape(Shape::Quad);
 
@@ -496,10 +520,7 @@ namespace nit
     )
     {
         NIT_CHECK_RENDERER_2D_CREATED
-        if (renderer_2d->circle_count >= MAX_PRIMITIVES)
-        {
-            next_batch();
-        }
+        reserve_primitive(&renderer_2d->circle_ring, renderer_2d->circle_count, sizeof(CircleVertex));
 
         SetCurrentShape(Shape::Circle);
 
@@ -548,10 +569,7 @@ namespace nit
     )
     {
         NIT_CHECK_RENDERER_2D_CREATED
-        if (renderer_2d->line_count >= MAX_PRIMITIVES)
-        {
-            next_batch();
-        }
+        reserve_primitive(&renderer_2d->line_ring, renderer_2d->line_count, sizeof(LineVertex));
 
         SetCurrentShape(Shape::Line);
 
@@ -579,10 +597,7 @@ namespace nit
     )
     {
         NIT_CHECK_RENDERER_2D_CREATED
-        if (renderer_2d->char_count >= MAX_PRIMITIVES)
-        {
-            next_batch();
-        }
+        reserve_primitive(&renderer_2d->char_ring, renderer_2d->char_count, sizeof(CharVertex));
 
         SetCurrentShape(Shape::Char);
 
@@ -657,9 +672,13 @@ namespace nit
 
         texture_2d_free(&renderer_2d->white_texture);
         renderer_2d->white_texture = {};
-        delete renderer_2d->quad_batch;
-        delete renderer_2d->circle_batch;
-        delete renderer_2d->line_batch;
-        delete renderer_2d->char_batch;
+        vertex_ring_free(&renderer_2d->quad_ring);
+        vertex_ring_free(&renderer_2d->circle_ring);
+        vertex_ring_free(&renderer_2d->line_ring);
+        vertex_ring_free(&renderer_2d->char_ring);
+        renderer_2d->quad_batch   = nullptr;
+        renderer_2d->circle_batch = nullptr;
+        renderer_2d->line_batch   = nullptr;
+        renderer_2d->char_batch   = nullptr;
     }
 }
\ No newline at end of file
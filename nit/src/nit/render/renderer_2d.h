@@ -2,6 +2,7 @@
 #include "primitives_2d.h"
 #include "texture.h"
 #include "camera.h"
+#include "vertex_ring.h"
 
 namespace nit
 {
@@ -9,6 +10,7 @@ namespace nit
     inline static constexpr u32 VERTICES_PER_PRIMITIVE = 4;
     inline static constexpr u32 INDICES_PER_PRIMITIVE = 6;
     inline static constexpr u32 MAX_TEXTURE_SLOTS = 32;
+    inline static constexpr u32 PRIMITIVES_PER_RING_REGION = 16384;
     
     struct VertexArray;
     struct VertexBuffer;
@@ -171,6 +173,7 @@ namespace nit
         Shape               current_shape      = Shape::None;
         u32                 quad_vao           = 0;
         u32                 quad_vbo           = 0;
+        VertexRing          quad_ring          = {};
         QuadVertex*         quad_batch         = nullptr;
         QuadVertex*         last_quad_vertex   = nullptr;
         SharedPtr<Material> quad_material      = nullptr;
@@ -179,6 +182,7 @@ namespace nit
         u32                 quad_index_count   = 0;
         u32                 circle_vao         = 0;
         u32                 circle_vbo         = 0;
+        VertexRing          circle_ring        = {};
         CircleVertex*       circle_batch       = nullptr;
         CircleVertex*       last_circle_vertex = nullptr;
         SharedPtr<Material> circle_material    = nullptr;
@@ -186,6 +190,7 @@ namespace nit
         u32                 circle_index_count = 0;
         u32                 line_vao           = 0;
         u32                 line_vbo           = 0;
+        VertexRing          line_ring          = {};
         LineVertex*         line_batch         = nullptr;
         LineVertex*         last_line_vertex   = nullptr;
         SharedPtr<Material> line_material      = nullptr;
@@ -193,6 +198,7 @@ namespace nit
         u32                 line_index_count   = 0;
         u32                 char_vao           = 0;
         u32                 char_vbo           = 0;
+        VertexRing          char_ring          = {};
         CharVertex*         char_batch         = nullptr;
         CharVertex*         last_char_vertex   = nullptr;
         SharedPtr<Material> char_material      = nullptr;
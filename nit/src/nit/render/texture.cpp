@@ -8,6 +8,10 @@
 #include "editor/editor_utils.h"
 #endif
 
+// Decoded images are accounted as asset memory and freed with memory_free (FreeTextureImage)
+#define STBI_MALLOC(size)        nit::memory_alloc(nit::MemoryTag::Asset, size)
+#define STBI_REALLOC(data, size) nit::memory_realloc(nit::MemoryTag::Asset, data, size)
+#define STBI_FREE(data)          nit::memory_free(data)
 #define STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb/stb_image_write.h>
@@ -198,7 +202,7 @@ namespace nit
             return;
         }
         
-        free(texture->pixel_data);
+        memory_free(texture->pixel_data);
         texture->pixel_data = nullptr;
     }
 
@@ -345,7 +349,7 @@ namespace nit
         i32 sprite_sheet_height = current_y_offset + max_row_height;
 
         const u32 pixel_data_count = sprite_sheet_width * sprite_sheet_height * 4;
-        texture->pixel_data = new u8[pixel_data_count];
+        texture->pixel_data = static_cast<u8*>(memory_alloc(MemoryTag::Asset, pixel_data_count));
         memset(texture->pixel_data, 0, pixel_data_count);
 
         current_x_offset = 0;
@@ -379,6 +383,9 @@ namespace nit
                     }
                 }
             }
+
+            stbi_image_free(image.data);
+            image.data = nullptr;
             
             SubTexture2D& sub_texture_2d = texture->sub_textures[i];
             sub_texture_2d.name = image.filename;
@@ -394,7 +401,7 @@ namespace nit
         
         stbi_write_png(full_path.c_str(), sprite_sheet_width, sprite_sheet_height, 4, texture->pixel_data, sprite_sheet_width * 4);
 
-        delete[] texture->pixel_data;
+        memory_free(texture->pixel_data);
         texture->pixel_data = nullptr;
 
         texture->image_path = final_path;
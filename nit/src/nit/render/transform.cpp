@@ -1,6 +1,7 @@
 ﻿#include "transform.h"
 #include "entity/entity.h"
 #include "entity/entity_utils.h"
+#include "entity/entity_view.h"
 
 #ifdef NIT_EDITOR_ENABLED
     #include "editor/editor_utils.h"
@@ -8,48 +9,91 @@
 
 namespace nit
 {
-    Matrix4 transform_to_matrix(Transform& transform, EntityID entity_id)
+    static GlobalTransform* global_transforms = nullptr;
+    static u32              last_update_tick  = 0;
+
+    static void combine(const GlobalTransform& parent, const Transform& local, GlobalTransform& global)
     {
-        const Matrix4 child_matrix = mat_create_transform(transform.position, transform.rotation, transform.scale);
+        global.position = to_v3(rotate_around(to_v2(parent.position), parent.rotation.z, to_v2(local.position + parent.position)));
+        global.rotation = local.rotation + parent.rotation;
+        global.scale    = multiply(local.scale, parent.scale);
+    }
 
-        if (!entity_valid(entity_id))
-        {
-            return child_matrix;
-        }
+    static bool has_transform_parent(EntityID entity, EntityID& parent)
+    {
+        parent = entity_get_parent(entity);
+        return entity_valid(parent) && entity_has<Transform>(parent);
+    }
 
-        EntityID parent = entity_get_parent(entity_id);
+    Matrix4 transform_to_matrix(const Transform& transform, EntityID entity_id)
+    {
+        EntityID parent;
         
-        if (!entity_valid(parent) || !entity_has<Transform>(parent))
+        if (!entity_valid(entity_id) || !global_transforms || !has_transform_parent(entity_id, parent))
         {
-            return child_matrix;
+            return mat_create_transform(transform.position, transform.rotation, transform.scale);
         }
 
-        Vector3 child_pos = transform.position;
-        Vector3 child_rot = transform.rotation;
-        Vector3 child_scl = transform.scale;
-        
-        while (entity_valid(entity_get_parent(entity_id)))
+        GlobalTransform global;
+        combine(global_transforms[entity_index(parent)], transform, global);
+        return mat_create_transform(global.position, global.rotation, global.scale);
+    }
+
+    static void update_global_transform(EntityID entity, EntityID parent, bool parent_changed)
+    {
+        GlobalTransform& global = global_transforms[entity_index(entity)];
+        const bool changed = parent_changed || global.parent != parent || entity_changed<Transform>(entity, last_update_tick);
+
+        if (changed)
         {
-            parent = entity_get_parent(entity_id);
+            const Transform& transform = entity_get_const<Transform>(entity);
 
-            if (!entity_valid(parent))
+            if (entity_valid(parent))
+            {
+                combine(global_transforms[entity_index(parent)], transform, global);
+            }
+            else
             {
-                break;
+                global.position = transform.position;
+                global.rotation = transform.rotation;
+                global.scale    = transform.scale;
             }
-            
-            const Transform& parent_transform = entity_get<Transform>(parent);
-            const Vector3& parent_pos = parent_transform.position;
-            const Vector3& parent_rot = parent_transform.rotation;
 
-            child_pos = child_pos + parent_pos;
-            child_pos = to_v3(rotate_around(to_v2(parent_pos), parent_rot.z, to_v2(child_pos)));
-        
-            child_rot = child_rot + parent_rot;
-            child_scl = multiply(child_scl, parent_transform.scale);
-            entity_id = entity_get_parent(entity_id);
+            global.matrix = mat_create_transform(global.position, global.rotation, global.scale);
+            global.parent = parent;
+        }
+
+        const EntityData* data = pool_get_data<EntityData>(&entity_registry_get_instance()->entities, entity);
+
+        for (EntityID child : data->children)
+        {
+            if (entity_valid(child) && entity_has<Transform>(child))
+            {
+                update_global_transform(child, entity, changed);
+            }
         }
-        
-        return mat_create_transform(child_pos, child_rot, child_scl);
+    }
+
+    void transform_update_global_transforms()
+    {
+        NIT_CHECK_MSG(global_transforms, "Transform component is not registered!");
+
+        // Starting from the roots keeps the parents updated before their children
+        for (auto [entity, transform] : entity_view<const Transform>())
+        {
+            if (EntityID parent; !has_transform_parent(entity, parent))
+            {
+                update_global_transform(entity, NULL_ENTITY, false);
+            }
+        }
+
+        last_update_tick = entity_advance_change_tick();
+    }
+
+    const GlobalTransform& transform_get_global(EntityID entity)
+    {
+        NIT_CHECK_MSG(global_transforms && entity_index(entity) < entity_registry_get_instance()->max_entities, "Invalid entity!");
+        return global_transforms[entity_index(entity)];
     }
 
     Vector3 transform_up(const Transform& transform)
@@ -92,6 +136,10 @@ namespace nit
     
     void register_transform_component()
     {
+        // Registered again when the entity registry gets initialized anew
+        memory_delete_array(global_transforms);
+        global_transforms = memory_new_array<GlobalTransform>(MemoryTag::Entity, entity_registry_get_instance()->max_entities);
+        
         component_register<Transform>
         ({
             .fn_serialize   = serialize,
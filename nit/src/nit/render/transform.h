@@ -9,8 +9,21 @@ namespace nit
         Vector3 rotation = V3_ZERO;
         Vector3 scale    = V3_ONE;
     };
+
+    // World space transform of an entity, its Transform combined with the ones of its parents. Cached per entity
+    // and refreshed once per frame by transform_update_global_transforms, only for the subtrees that changed.
+    struct GlobalTransform
+    {
+        Vector3  position = V3_ZERO;
+        Vector3  rotation = V3_ZERO;
+        Vector3  scale    = V3_ONE;
+        Matrix4  matrix;
+        EntityID parent   = NULL_ENTITY;
+    };
     
-    Matrix4 transform_to_matrix(Transform& transform, EntityID entity_id = NULL_ENTITY);
+    Matrix4                transform_to_matrix(const Transform& transform, EntityID entity_id = NULL_ENTITY);
+    void                   transform_update_global_transforms();
+    const GlobalTransform& transform_get_global(EntityID entity);
     Vector3 transform_up(const Transform& transform);
     Vector3 transform_right(const Transform& transform);
     Vector3 transform_front(const Transform& transform);
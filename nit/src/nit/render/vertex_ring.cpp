@@ -0,0 +1,107 @@
+#include "vertex_ring.h"
+#include "render_api.h"
+#include "render_objects.h"
+
+namespace nit
+{
+    void vertex_ring_load(VertexRing* ring, u64 region_size)
+    {
+        NIT_CHECK(ring && !ring->mapped && region_size > 0);
+        const u64 size = region_size * VERTEX_RING_REGIONS;
+
+        const u32 vertex_buffer = create_persistent_vertex_buffer(size);
+        u8*       mapped        = static_cast<u8*>(get_vertex_buffer_data(vertex_buffer).mapped);
+        const bool staging      = mapped == nullptr;
+
+        if (staging)
+        {
+            mapped = static_cast<u8*>(memory_alloc(MemoryTag::Render, size));
+        }
+
+        VertexRingDevice device;
+        device.fn_create_fence  = create_fence;
+        device.fn_wait_fence    = wait_fence;
+        device.fn_destroy_fence = destroy_fence;
+        device.fn_upload        = set_vertex_buffer_data;
+
+        vertex_ring_init(ring, region_size, mapped, staging, device, vertex_buffer);
+    }
+
+    void vertex_ring_init(VertexRing* ring, u64 region_size, u8* mapped, bool staging, const VertexRingDevice& device, u32 vertex_buffer)
+    {
+        NIT_CHECK(ring && !ring->mapped && mapped && region_size > 0);
+        NIT_CHECK(device.fn_create_fence && device.fn_wait_fence && device.fn_destroy_fence && device.fn_upload);
+
+        *ring = {};
+        ring->vertex_buffer = vertex_buffer;
+        ring->mapped        = mapped;
+        ring->staging       = staging;
+        ring->region_size   = region_size;
+        ring->device        = device;
+    }
+
+    void vertex_ring_free(VertexRing* ring)
+    {
+        NIT_CHECK(ring);
+        if (!ring->mapped)
+        {
+            return;
+        }
+
+        for (void* fence : ring->fences)
+        {
+            ring->device.fn_destroy_fence(fence);
+        }
+
+        // Rings set up over memory of the caller have no buffer of their own
+        if (ring->vertex_buffer)
+        {
+            if (ring->staging)
+            {
+                memory_free(ring->mapped);
+            }
+
+            destroy_vertex_buffer(ring->vertex_buffer);
+        }
+
+        *ring = {};
+    }
+
+    u8* vertex_ring_head(const VertexRing* ring)
+    {
+        return ring->mapped + ring->region * ring->region_size + ring->head;
+    }
+
+    bool vertex_ring_fits(const VertexRing* ring, u64 size)
+    {
+        return ring->head + size <= ring->region_size;
+    }
+
+    void vertex_ring_commit(VertexRing* ring, u64 size)
+    {
+        NIT_CHECK(vertex_ring_fits(ring, size));
+
+        if (ring->staging)
+        {
+            ring->device.fn_upload(ring->vertex_buffer, vertex_ring_head(ring), size, vertex_ring_head(ring) - ring->mapped);
+        }
+
+        ring->head += size;
+    }
+
+    void vertex_ring_next_region(VertexRing* ring)
+    {
+        if (!ring->staging)
+        {
+            ring->device.fn_destroy_fence(ring->fences[ring->region]);
+            ring->fences[ring->region] = ring->device.fn_create_fence();
+        }
+
+        ring->region = (ring->region + 1) % VERTEX_RING_REGIONS;
+        ring->head   = 0;
+
+        ring->device.fn_wait_fence(ring->fences[ring->region]);
+        ring->device.fn_destroy_fence(ring->fences[ring->region]);
+        ring->fences[ring->region] = nullptr;
+    }
+}
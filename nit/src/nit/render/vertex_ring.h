@@ -0,0 +1,43 @@
+#pragma once
+
+namespace nit
+{
+    inline static constexpr u32 VERTEX_RING_REGIONS = 3;
+
+    // GPU side of the ring. vertex_ring_load plugs in the render api, the ring itself only goes through these so it
+    // can also run without a render context.
+    struct VertexRingDevice
+    {
+        void* (*fn_create_fence)()                                                    = nullptr;
+        void  (*fn_wait_fence)(void* fence)                                           = nullptr; // Null fences return at once
+        void  (*fn_destroy_fence)(void* fence)                                        = nullptr; // Null fences are ignored
+        void  (*fn_upload)(u32 vertex_buffer, const void* data, u64 size, u64 offset) = nullptr; // Only used when staging
+    };
+
+    // Vertex buffer split in regions that the CPU fills while the GPU still reads the previous ones. Leaving a region
+    // places a fence on it and entering a region waits for its fence, so the CPU never overwrites vertices that are
+    // in flight. The vertices are written straight into the persistent mapping, batches never span two regions.
+    struct VertexRing
+    {
+        u32              vertex_buffer = 0;
+        u8*              mapped        = nullptr; // Mapping of the whole buffer, CPU memory if persistent mapping is not supported
+        bool             staging       = false;   // True when mapped is CPU memory that has to be uploaded on commit
+        u64              region_size   = 0;
+        u32              region        = 0;
+        u64              head          = 0;       // Bytes already committed in the current region
+        void*            fences[VERTEX_RING_REGIONS] = {};
+        VertexRingDevice device;
+    };
+
+    // Creates the vertex buffer with the render api and maps it
+    void vertex_ring_load(VertexRing* ring, u64 region_size);
+
+    // Sets up the ring over region_size * VERTEX_RING_REGIONS bytes of mapped memory. Without a vertex_buffer the memory
+    // belongs to the caller and vertex_ring_free leaves it alone.
+    void vertex_ring_init(VertexRing* ring, u64 region_size, u8* mapped, bool staging, const VertexRingDevice& device, u32 vertex_buffer = 0);
+    void vertex_ring_free(VertexRing* ring);
+    u8*  vertex_ring_head(const VertexRing* ring);
+    bool vertex_ring_fits(const VertexRing* ring, u64 size);
+    void vertex_ring_commit(VertexRing* ring, u64 size);
+    void vertex_ring_next_region(VertexRing* ring);
+}
@@ -17,6 +17,7 @@
 #include <map>
 #include <unordered_set>
 #include <bitset>
+#include <bit>
 #include <queue>
 #include <set>
 #include <yaml-cpp/yaml.h>
@@ -25,6 +26,8 @@
 #ifdef NIT_IMGUI_ENABLED
 #include <imgui.h>
 #endif
+#include "nit/core/memory.h"
+#include "nit/core/profiler.h"
 #include "nit/core/event.h"
 #include "nit/core/type.h"
 #include "nit/core/uuid.h"
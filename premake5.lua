@@ -2,12 +2,23 @@ outputdir                      = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architectu
 binariesdir                    = "%{wks.location}/bin/"     .. outputdir .. "/%{prj.name}"
 intermediatesdir               = "%{wks.location}/bin-int/" .. outputdir .. "/%{prj.name}"
 
+newoption
+{
+    trigger     = "allocation-counter",
+    description = "Count the heap allocations of every frame by replacing the global operator new and delete"
+}
+
 workspace "nit"
 
     architecture   "x86_64"
     configurations { "Debug", "Release", "Dist" }
     startproject   "bb"
 
+    filter "options:allocation-counter"
+        defines "NIT_ALLOCATION_COUNTER"
+
+    filter {}
+
 project "nit"
 
     kind          "StaticLib"
@@ -76,6 +87,7 @@ project "nit"
         {
             "OpenGL",
             "hidapi-hidraw",   
+            "pthread",
         }
 
     filter "configurations:Debug"
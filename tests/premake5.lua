@@ -0,0 +1,51 @@
+project "tests"
+
+    kind          "ConsoleApp"
+    language      "C++"
+    cppdialect    "C++20"
+    targetdir     (binariesdir)
+    objdir        (intermediatesdir)
+    pchheader     "tests_pch.h"
+    pchsource     "src/tests_pch.cpp"
+    forceincludes { "tests_pch.h" }
+    
+    defines
+    {
+    }
+
+    disablewarnings 
+    {
+    }
+
+    includedirs 
+    {
+        "../nit/src",
+        "src",
+        "../3rd/imgui/src",
+        "../3rd/yaml/include"
+    }
+    
+    links
+    {
+        "nit"
+    }
+
+    files { "src/**.h", "src/**.cpp" }
+
+    filter "configurations:Debug"
+        symbols "On"
+        runtime "Debug"
+        defines "NIT_DEBUG"
+
+    filter "configurations:Release"
+        optimize "On"
+        runtime "Release"
+        defines "NIT_RELEASE"
+
+    filter "configurations:Dist"
+		runtime "Release"
+		optimize "On"
+        defines "NIT_DIST"
+
+    filter "system:windows"
+        systemversion "latest"
@@ -0,0 +1,129 @@
+#include "test.h"
+
+using namespace nit;
+
+// The Move component of the app and the Sprite every moving quad carries along
+struct Mover
+{
+    Vector2 velocity;
+    Vector2 destination;
+};
+
+struct Tint
+{
+    Vector4 color = V4_ONE;
+};
+
+// random_value seeds a new engine on every call, which would take most of the creation time at a million entities
+static f32 next_random(f32 min, f32 max)
+{
+    static u32 state = 2463534242u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return min + (max - min) * (f32) (state >> 8) / (f32) (1u << 24);
+}
+
+static Vector2 next_random_point()
+{
+    return { next_random(-20.f, 20.f), next_random(-10.f, 10.f) };
+}
+
+static void reset_mover(const Transform& transform, Mover& mover)
+{
+    mover.destination = next_random_point();
+    mover.velocity    = normalize(mover.destination - to_v2(transform.position)) * next_random(1.f, 15.f);
+}
+
+// game_update of the app, without the parallel_for so both backends are measured on the same single thread
+static void move_update(Transform& transform, Mover& mover)
+{
+    if (distance(to_v2(transform.position), mover.destination) < 0.1f)
+    {
+        reset_mover(transform, mover);
+    }
+    else
+    {
+        transform.position += to_v3(mover.velocity * delta_seconds());
+    }
+}
+
+struct StorageTimes
+{
+    f64 create_ms  = 0.0;
+    f64 view_ms    = 0.0;
+    f64 columns_ms = 0.0;
+};
+
+static StorageTimes run_move_workload(EntityStorage storage, u32 entity_count)
+{
+    constexpr u32 FRAMES = 10;
+
+    test_set_registry(storage, entity_count);
+    test_component_register<Mover>();
+    test_component_register<Tint>();
+
+    if (storage == EntityStorage::Pool)
+    {
+        entity_create_group<Transform, Mover>();
+    }
+
+    StorageTimes times;
+    f64 start = test_now_ms();
+
+    for (u32 i = 0; i < entity_count; ++i)
+    {
+        EntityID entity = entity_create();
+        Transform& transform = entity_add<Transform>(entity);
+        transform.position = to_v3(next_random_point());
+        entity_add<Tint>(entity);
+        reset_mover(entity_get_const<Transform>(entity), entity_add<Mover>(entity));
+    }
+
+    times.create_ms = test_now_ms() - start;
+    start = test_now_ms();
+
+    for (u32 frame = 0; frame < FRAMES; ++frame)
+    {
+        for (auto [entity, transform, mover] : entity_view<Transform, Mover>())
+        {
+            move_update(transform, mover);
+        }
+    }
+
+    times.view_ms = (test_now_ms() - start) / FRAMES;
+
+    if (storage == EntityStorage::Archetype)
+    {
+        start = test_now_ms();
+
+        for (u32 frame = 0; frame < FRAMES; ++frame)
+        {
+            archetype_for_each<Transform, Mover>([](EntityID, Transform& transform, Mover& mover)
+            {
+                move_update(transform, mover);
+            });
+        }
+
+        times.columns_ms = (test_now_ms() - start) / FRAMES;
+    }
+
+    // Dropped with the registry, destroying a million entities one by one would take longer than the workload
+    return times;
+}
+
+NIT_BENCHMARK(entity_storage_move_workload)
+{
+    constexpr u32 ENTITY_COUNTS[] = { 10000, 100000, 1000000 };
+
+    for (u32 entity_count : ENTITY_COUNTS)
+    {
+        const StorageTimes pool      = run_move_workload(EntityStorage::Pool, entity_count);
+        const StorageTimes archetype = run_move_workload(EntityStorage::Archetype, entity_count);
+
+        test_report("%7u entities, pool:      create %8.1f ms, entity_view %7.2f ms/frame",
+            entity_count, pool.create_ms, pool.view_ms);
+        test_report("%7u entities, archetype: create %8.1f ms, entity_view %7.2f ms/frame, archetype_for_each %7.2f ms/frame",
+            entity_count, archetype.create_ms, archetype.view_ms, archetype.columns_ms);
+    }
+}
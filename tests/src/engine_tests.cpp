@@ -0,0 +1,217 @@
+#include "test.h"
+
+using namespace nit;
+
+// The Move system of app/src/main.cpp with the random destinations replaced by a hash of the entity seed, so two
+// runs can be compared bit by bit
+struct Move
+{
+    Vector2 velocity;
+    Vector2 destination;
+    u32     seed = 0;
+    u32     hops = 0;
+};
+
+struct Blink
+{
+    f32     time = 0.f;
+    Vector4 tint = V4_ONE;
+};
+
+static constexpr Vector2 RECT_LEFT  = { -100.f, 100.f };
+static constexpr Vector2 RECT_RIGHT = { 100.f, -100.f };
+static constexpr f32     MIN_SPEED  = 1.f;
+static constexpr f32     MAX_SPEED  = 15.f;
+
+static f32 hash_value(u32 seed, u32 salt, f32 min, f32 max)
+{
+    u32 x = seed * 0x9E3779B1u ^ salt * 0x85EBCA77u;
+    x ^= x >> 15;
+    x *= 0x2C1B3C6Du;
+    x ^= x >> 12;
+    return min + (max - min) * (f32) (x & 0xFFFFFF) / (f32) 0x1000000;
+}
+
+static void reset_movement(const Transform& transform, Move& move)
+{
+    const f32 speed  = hash_value(move.seed, move.hops * 3, MIN_SPEED, MAX_SPEED);
+    move.destination = { hash_value(move.seed, move.hops * 3 + 1, RECT_LEFT.x, RECT_RIGHT.x), hash_value(move.seed, move.hops * 3 + 2, RECT_RIGHT.y, RECT_LEFT.y) };
+    move.velocity    = normalize(move.destination - to_v2(transform.position)) * speed;
+    ++move.hops;
+}
+
+static ListenerAction move_update()
+{
+    parallel_for(entity_view<Transform, Move>(), 256, [](EntityID, Transform& transform, Move& move)
+    {
+        if (distance(to_v2(transform.position), move.destination) < 0.1f)
+        {
+            reset_movement(transform, move);
+        }
+        else
+        {
+            transform.position += to_v3(move.velocity * delta_seconds());
+        }
+    });
+
+    return ListenerAction::StayListening;
+}
+
+static ListenerAction blink_update()
+{
+    parallel_for(entity_view<Blink>(), 256, [](EntityID, Blink& blink)
+    {
+        blink.time  += delta_seconds();
+        blink.tint.w = 0.5f + 0.5f * std::sin(blink.time * 4.f);
+    });
+
+    return ListenerAction::StayListening;
+}
+
+static void spawn_movers(Array<EntityID>& entities, u32 count)
+{
+    test_component_register<Move>();
+    test_component_register<Blink>();
+
+    for (u32 i = 0; i < count; ++i)
+    {
+        EntityID entity = entity_create();
+        Transform& transform = entity_add<Transform>(entity);
+        transform.position   = { hash_value(i, U32_MAX, RECT_LEFT.x, RECT_RIGHT.x), hash_value(i, U32_MAX - 1, RECT_RIGHT.y, RECT_LEFT.y), 0.f };
+        Move& move           = entity_add<Move>(entity, { .seed = i });
+        reset_movement(transform, move);
+        entity_add<Blink>(entity, { .time = (f32) i });
+        entities.push_back(entity);
+    }
+
+    entity_flush_events();
+
+    // Both systems declare their access and don't conflict, so each frame runs them at the same time
+    engine_event(Stage::Update) += EngineListener::create(move_update);
+    engine_event(Stage::Update) += EngineListener::create(blink_update);
+    engine_system_access(EngineListener::create(move_update), {}, entity_build_signature<Transform, Move>());
+    engine_system_access(EngineListener::create(blink_update), {}, entity_build_signature<Blink>());
+}
+
+static void destroy_movers(Array<EntityID>& entities)
+{
+    engine_event(Stage::Update) -= EngineListener::create(move_update);
+    engine_event(Stage::Update) -= EngineListener::create(blink_update);
+
+    for (EntityID entity : entities)
+    {
+        entity_destroy(entity);
+    }
+
+    entity_flush_events();
+    entities.clear();
+}
+
+// Simulates frame_count frames and returns the final state of every entity in creation order
+static Array<f32> run_movers(u32 thread_count, u32 entity_count, u32 frame_count)
+{
+    test_set_threads(thread_count);
+
+    Array<EntityID> entities;
+    spawn_movers(entities, entity_count);
+
+    for (u32 frame = 0; frame < frame_count; ++frame)
+    {
+        engine_broadcast_concurrent(Stage::Update);
+    }
+
+    Array<f32> state;
+
+    for (EntityID entity : entities)
+    {
+        const Transform& transform = entity_get_const<Transform>(entity);
+        const Move&      move      = entity_get_const<Move>(entity);
+        state.push_back(transform.position.x);
+        state.push_back(transform.position.y);
+        state.push_back((f32) move.hops);
+        state.push_back(entity_get_const<Blink>(entity).tint.w);
+    }
+
+    destroy_movers(entities);
+    return state;
+}
+
+NIT_TEST(engine_concurrent_systems_are_deterministic)
+{
+    const Array<f32> expected = run_movers(1, 5000, 600);
+
+    for (u32 thread_count : { 2u, 4u, 8u })
+    {
+        const Array<f32> state = run_movers(thread_count, 5000, 600);
+        TEST_CHECK(state.size() == expected.size());
+        TEST_CHECK(std::memcmp(state.data(), expected.data(), state.size() * sizeof(f32)) == 0);
+    }
+}
+
+NIT_BENCHMARK(engine_concurrent_systems_scaling)
+{
+    constexpr u32 ENTITY_COUNT = 100000;
+    constexpr u32 FRAME_COUNT  = 200;
+
+    for (u32 thread_count : { 1u, 2u, 4u, 8u })
+    {
+        test_set_threads(thread_count);
+
+        Array<EntityID> entities;
+        spawn_movers(entities, ENTITY_COUNT);
+
+        const f64 start = test_now_ms();
+
+        for (u32 frame = 0; frame < FRAME_COUNT; ++frame)
+        {
+            engine_broadcast_concurrent(Stage::Update);
+        }
+
+        test_report("%u threads, %u entities: %.3f ms per frame", thread_count, ENTITY_COUNT, (test_now_ms() - start) / FRAME_COUNT);
+        destroy_movers(entities);
+    }
+}
+
+struct Watched
+{
+    u32 value = 0;
+};
+
+static u32 watched_group_size = U32_MAX;
+
+static ListenerAction watch_update()
+{
+    watched_group_size = entity_get_group<Watched>().entities.count;
+    return ListenerAction::StayListening;
+}
+
+NIT_TEST(engine_concurrent_systems_defer_missing_groups)
+{
+    test_set_threads(2);
+    test_component_register<Watched>();
+
+    Array<EntityID> entities;
+    spawn_movers(entities, 100);
+
+    for (u32 i = 0; i < 10; ++i)
+    {
+        entities.push_back(entity_create());
+        entity_add<Watched>(entities.back());
+    }
+
+    engine_event(Stage::Update) += EngineListener::create(watch_update);
+    engine_system_access(EngineListener::create(watch_update), entity_build_signature<Watched>(), {});
+    const EntitySignature signature = entity_build_signature<Watched>();
+    TEST_CHECK(!entity_registry_get_instance()->entity_groups.contains(signature));
+
+    // The first frame gets an empty group while the batch runs, the group exists after it
+    engine_broadcast_concurrent(Stage::Update);
+    TEST_CHECK(watched_group_size == 0);
+    TEST_CHECK(entity_registry_get_instance()->entity_groups.contains(signature));
+
+    engine_broadcast_concurrent(Stage::Update);
+    TEST_CHECK(watched_group_size == 10);
+
+    engine_event(Stage::Update) -= EngineListener::create(watch_update);
+    destroy_movers(entities);
+}
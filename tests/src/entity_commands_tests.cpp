@@ -0,0 +1,249 @@
+#include "test.h"
+
+using namespace nit;
+
+struct Health
+{
+    f32 current = 100.f;
+};
+
+static u32 health_added = 0;
+
+static ListenerAction on_health_added(const ComponentAddedArgs&)
+{
+    ++health_added;
+    return ListenerAction::StayListening;
+}
+
+NIT_TEST(entity_commands_overwrite_does_not_broadcast_again)
+{
+    test_component_register<Health>();
+    entity_on_add<Health>() += ComponentAddedListener::create(on_health_added);
+    health_added = 0;
+
+    EntityID entity = entity_create();
+    entity_commands_add<Health>(entity_commands(), entity, { .current = 10.f });
+    entity_commands_playback();
+    TEST_CHECK(health_added == 1);
+    TEST_CHECK(entity_get_const<Health>(entity).current == 10.f);
+
+    // The entity already has it, the data gets overwritten and the observers are not told twice
+    entity_commands_add<Health>(entity_commands(), entity, { .current = 20.f });
+    entity_commands_add<Health>(entity_commands(), entity, { .current = 30.f });
+    entity_commands_playback();
+    TEST_CHECK(health_added == 1);
+    TEST_CHECK(entity_get_const<Health>(entity).current == 30.f);
+
+    // Removing it in one playback and adding it in the next is a real addition again
+    entity_commands_remove<Health>(entity_commands(), entity);
+    entity_commands_playback();
+    TEST_CHECK(!entity_has<Health>(entity));
+
+    entity_commands_add<Health>(entity_commands(), entity);
+    entity_commands_playback();
+    TEST_CHECK(health_added == 2);
+
+    entity_on_add<Health>() -= ComponentAddedListener::create(on_health_added);
+    entity_destroy(entity);
+    entity_flush_events();
+}
+
+NIT_TEST(entity_commands_add_to_pending_entity)
+{
+    test_component_register<Health>();
+    entity_on_add<Health>() += ComponentAddedListener::create(on_health_added);
+    health_added = 0;
+
+    EntityCommandBuffer* commands = entity_commands();
+    EntityID pending = entity_commands_create(commands, "Pending");
+    TEST_CHECK(entity_is_pending(pending));
+    entity_commands_add<Health>(commands, pending, { .current = 5.f });
+    entity_commands_playback();
+
+    TEST_CHECK(health_added == 1);
+
+    u32 found = 0;
+
+    for (auto [entity, health] : entity_view<const Health>())
+    {
+        found += health.current == 5.f;
+        entity_commands_destroy(entity_commands(), entity);
+    }
+
+    // Destroying the entities of the view while iterating it is deferred to the playback
+    TEST_CHECK(found == 1);
+    entity_commands_playback();
+
+    found = 0;
+
+    for (auto [entity, health] : entity_view<const Health>())
+    {
+        found += health.current == 5.f;
+    }
+
+    TEST_CHECK(found == 0);
+
+    entity_on_add<Health>() -= ComponentAddedListener::create(on_health_added);
+    entity_flush_events();
+}
+
+struct Armor
+{
+    f32 value = 0.f;
+};
+
+static EntityID        armor_target  = NULL_ENTITY;
+static bool            armor_destroy = false;
+static Array<EntityID> armor_added;
+
+// Runs before the Armor adds get broadcast, Health is registered first
+static ListenerAction on_health_added_drop_armor(const ComponentAddedArgs& args)
+{
+    if (args.entity != armor_target)
+    {
+        return ListenerAction::StayListening;
+    }
+
+    if (armor_destroy)
+    {
+        entity_destroy(args.entity);
+    }
+    else
+    {
+        entity_remove<Armor>(args.entity);
+    }
+
+    return ListenerAction::StayListening;
+}
+
+static ListenerAction on_armor_added(const ComponentAddedArgs& args)
+{
+    armor_added.push_back(args.entity);
+    return ListenerAction::StayListening;
+}
+
+// The first entity loses its Armor to a Health listener, the second one already had it and the third one gets it
+static void playback_with_listener_changes(bool destroy)
+{
+    test_component_register<Health>();
+    test_component_register<Armor>();
+    entity_on_add<Health>() += ComponentAddedListener::create(on_health_added_drop_armor);
+    entity_on_add<Armor>()  += ComponentAddedListener::create(on_armor_added);
+
+    EntityID first  = entity_create();
+    EntityID second = entity_create();
+    EntityID third  = entity_create();
+    entity_add<Armor>(second, { .value = 1.f }, false);
+
+    armor_target  = first;
+    armor_destroy = destroy;
+    armor_added.clear();
+
+    EntityCommandBuffer* commands = entity_commands();
+    entity_commands_add<Health>(commands, first);
+    entity_commands_add<Armor>(commands, first, { .value = 5.f });
+    entity_commands_add<Armor>(commands, second, { .value = 2.f });
+    entity_commands_add<Armor>(commands, third, { .value = 3.f });
+    entity_commands_playback();
+
+    TEST_CHECK(armor_added.size() == 1 && armor_added[0] == third);
+    TEST_CHECK(entity_valid(first) != destroy);
+    TEST_CHECK(!entity_valid(first) || !entity_has<Armor>(first));
+    TEST_CHECK(entity_get_const<Armor>(second).value == 2.f);
+    TEST_CHECK(entity_get_const<Armor>(third).value == 3.f);
+
+    entity_on_add<Health>() -= ComponentAddedListener::create(on_health_added_drop_armor);
+    entity_on_add<Armor>()  -= ComponentAddedListener::create(on_armor_added);
+
+    for (EntityID entity : { first, second, third })
+    {
+        if (entity_valid(entity))
+        {
+            entity_destroy(entity);
+        }
+    }
+
+    entity_flush_events();
+}
+
+NIT_TEST(entity_commands_listener_destroys_entity_with_later_adds)
+{
+    playback_with_listener_changes(true);
+}
+
+NIT_TEST(entity_commands_listener_removes_later_add_with_archetypes)
+{
+    test_set_registry(EntityStorage::Archetype, entity_registry_get_instance()->max_entities);
+    playback_with_listener_changes(false);
+}
+
+// Owns memory like most gameplay components, so the pools move it around instead of copying bytes
+struct Bullet
+{
+    Vector2    velocity;
+    f32        life = 0.f;
+    String     owner;
+    Array<u32> hits;
+};
+
+// One second of a game that fires spawns_per_second bullets living life_seconds each, spawned and destroyed through
+// the command buffer. Returns the ms of the whole second.
+static f64 fire_bullets(u32 spawns_per_second, f32 life_seconds)
+{
+    constexpr u32 FRAMES = 60;
+    const f32 frame_seconds = 1.f / FRAMES;
+    const u32 spawns_per_frame = spawns_per_second / FRAMES;
+
+    test_component_register<Bullet>();
+    const f64 start = test_now_ms();
+
+    for (u32 frame = 0; frame < FRAMES; ++frame)
+    {
+        for (auto [entity, transform, bullet] : entity_view<Transform, Bullet>())
+        {
+            bullet.life -= frame_seconds;
+            transform.position += to_v3(bullet.velocity * frame_seconds);
+
+            if (bullet.life <= 0.f)
+            {
+                entity_commands_destroy(entity_commands(), entity);
+            }
+        }
+
+        EntityCommandBuffer* commands = entity_commands();
+
+        for (u32 i = 0; i < spawns_per_frame; ++i)
+        {
+            EntityID bullet = entity_commands_create(commands);
+            entity_commands_add<Transform>(commands, bullet);
+            entity_commands_add<Bullet>(commands, bullet, { .velocity = { 10.f, (f32) (i % 7) }, .life = life_seconds, .owner = "Player" });
+        }
+
+        entity_commands_playback();
+    }
+
+    const f64 elapsed = test_now_ms() - start;
+
+    for (auto [entity, bullet] : entity_view<const Bullet>())
+    {
+        entity_commands_destroy(entity_commands(), entity);
+    }
+
+    entity_commands_playback();
+    entity_flush_events();
+    return elapsed;
+}
+
+NIT_BENCHMARK(entity_commands_50k_bullets_per_second)
+{
+    constexpr u32 SPAWNS_PER_SECOND = 50000;
+    constexpr f32 LIFE_SECONDS      = 0.5f;
+
+    const f64 pool_ms = fire_bullets(SPAWNS_PER_SECOND, LIFE_SECONDS);
+
+    test_set_registry(EntityStorage::Archetype, entity_registry_get_instance()->max_entities);
+    const f64 archetype_ms = fire_bullets(SPAWNS_PER_SECOND, LIFE_SECONDS);
+
+    test_report("pool storage:      %.1f ms for one second (%.2f ms per frame)", pool_ms, pool_ms / 60.0);
+    test_report("archetype storage: %.1f ms for one second (%.2f ms per frame)", archetype_ms, archetype_ms / 60.0);
+}
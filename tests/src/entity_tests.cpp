@@ -0,0 +1,217 @@
+#include "test.h"
+
+using namespace nit;
+
+// Components registered ahead of the looked up one, the scan the slot lookup replaced walks over all of them
+template<u32 N>
+struct Filler
+{
+    u32 value = N;
+};
+
+struct Lookup
+{
+    u32 value = 0;
+};
+
+template<u32... N>
+static void register_fillers(std::integer_sequence<u32, N...>)
+{
+    (test_component_register<Filler<N>>(), ...);
+}
+
+// entity_get_ptr before the per type slot, the pool was found comparing the type with every registered pool
+template<typename T>
+static T* scan_get_ptr(EntityID entity)
+{
+    NIT_CHECK_MSG(entity_valid(entity), "Invalid entity!");
+    ComponentPool* component_pool = entity_find_component_pool(type_get<T>());
+    NIT_CHECK_MSG(component_pool, "Invalid component type!");
+    return pool_get_data<T>(&component_pool->data_pool, entity);
+}
+
+NIT_TEST(entity_registry_reinit_registers_again)
+{
+    test_component_register<Lookup>();
+    const u32 type_index = component_type_index<Lookup>;
+    TEST_CHECK(type_index != 0);
+
+    // Finishing the registry clears the slots, the types get new ones in the order they are registered again
+    test_set_registry(EntityStorage::Pool, 1000);
+    TEST_CHECK(component_type_index<Lookup> == 0);
+    TEST_CHECK(entity_find_component_pool<Lookup>() == nullptr);
+
+    test_component_register<Lookup>();
+    TEST_CHECK(component_type_index<Lookup> == component_type_index<Transform> + 1);
+
+    EntityID entity = entity_create();
+    entity_add<Lookup>(entity, { .value = 3 });
+    TEST_CHECK(entity_get_const<Lookup>(entity).value == 3);
+    TEST_CHECK(entity_find_component_pool<Lookup>() == entity_find_component_pool(type_get<Lookup>()));
+    entity_destroy(entity);
+    entity_flush_events();
+}
+
+NIT_TEST(entity_for_each_enabled_passes_handles)
+{
+    // Indices only get reused once all of them were handed out
+    test_set_registry(EntityStorage::Pool, 2);
+    EntityID recycled = entity_create();
+    EntityID disabled = entity_create();
+    entity_set_enabled(disabled, false);
+
+    // The index comes back with a newer generation, a bare index would not be a valid handle for it
+    entity_destroy(recycled);
+    recycled = entity_create();
+    TEST_CHECK(entity_generation(recycled) != 0);
+
+    bool found_recycled = false;
+    bool found_disabled = false;
+    bool all_valid      = true;
+
+    entity_for_each_enabled([&](EntityID entity)
+    {
+        found_recycled |= entity == recycled;
+        found_disabled |= entity == disabled;
+        all_valid      &= entity_valid(entity);
+    });
+
+    TEST_CHECK(found_recycled);
+    TEST_CHECK(!found_disabled);
+    TEST_CHECK(all_valid);
+
+    entity_destroy(recycled);
+    entity_destroy(disabled);
+    entity_flush_events();
+}
+
+NIT_BENCHMARK(entity_get_100k)
+{
+    constexpr u32 ENTITY_COUNT = 100000;
+    constexpr u32 ROUNDS       = 20;
+
+    register_fillers(std::make_integer_sequence<u32, 16>());
+    test_component_register<Lookup>();
+
+    Array<EntityID> entities;
+
+    for (u32 i = 0; i < ENTITY_COUNT; ++i)
+    {
+        EntityID entity = entity_create();
+        entity_add<Lookup>(entity, { .value = i });
+        entities.push_back(entity);
+    }
+
+    u64 sum = 0;
+
+    f64 start = test_now_ms();
+    for (u32 round = 0; round < ROUNDS; ++round)
+    {
+        for (EntityID entity : entities)
+        {
+            sum += scan_get_ptr<Lookup>(entity)->value;
+        }
+    }
+    const f64 scan_ms = (test_now_ms() - start) / ROUNDS;
+
+    start = test_now_ms();
+    for (u32 round = 0; round < ROUNDS; ++round)
+    {
+        for (EntityID entity : entities)
+        {
+            sum += entity_get<Lookup>(entity).value;
+        }
+    }
+    const f64 get_ms = (test_now_ms() - start) / ROUNDS;
+
+    start = test_now_ms();
+    for (u32 round = 0; round < ROUNDS; ++round)
+    {
+        for (EntityID entity : entities)
+        {
+            sum += entity_get_const<Lookup>(entity).value;
+        }
+    }
+    const f64 get_const_ms = (test_now_ms() - start) / ROUNDS;
+
+    test_report("%u registered components", entity_registry_get_instance()->next_component_type_index - 1);
+    test_report("pool scan (before):  %.3f ms", scan_ms);
+    test_report("entity_get:          %.3f ms", get_ms);
+    test_report("entity_get_const:    %.3f ms (checksum %llu)", get_const_ms, (unsigned long long) sum);
+
+    for (EntityID entity : entities)
+    {
+        entity_destroy(entity);
+    }
+
+    entity_flush_events();
+}
+
+struct Toggled
+{
+    u32 value = 0;
+};
+
+NIT_BENCHMARK(entity_group_toggle_100k)
+{
+    constexpr u32 ENTITY_COUNT = 100000;
+    constexpr u32 FRAMES       = 20;
+
+    register_fillers(std::make_integer_sequence<u32, 16>());
+    test_component_register<Toggled>();
+
+    // Groups that contain the toggled component and groups that don't, only the first ones get re-evaluated
+    EntityGroup& toggled_group = entity_get_group(entity_create_group<Transform, Toggled>());
+    entity_create_group<Toggled>();
+    entity_create_group<Transform, Filler<0>>();
+    entity_create_group<Transform, Filler<1>>();
+    entity_create_group<Filler<0>, Filler<1>>();
+    entity_create_group<Transform>();
+
+    Array<EntityID> entities;
+
+    for (u32 i = 0; i < ENTITY_COUNT; ++i)
+    {
+        EntityID entity = entity_create();
+        entity_add<Transform>(entity);
+        entity_add<Filler<0>>(entity);
+        entities.push_back(entity);
+    }
+
+    f64 add_ms    = 0.0;
+    f64 remove_ms = 0.0;
+
+    for (u32 frame = 0; frame < FRAMES; ++frame)
+    {
+        f64 start = test_now_ms();
+
+        for (EntityID entity : entities)
+        {
+            entity_add<Toggled>(entity);
+        }
+
+        add_ms += test_now_ms() - start;
+        TEST_CHECK(toggled_group.entities.count == ENTITY_COUNT);
+        start = test_now_ms();
+
+        for (EntityID entity : entities)
+        {
+            entity_remove<Toggled>(entity);
+        }
+
+        remove_ms += test_now_ms() - start;
+        TEST_CHECK(toggled_group.entities.count == 0);
+    }
+
+    test_report("%u groups", (u32) entity_registry_get_instance()->entity_groups.size());
+    test_report("add to 100k:      %.2f ms/frame", add_ms / FRAMES);
+    test_report("remove from 100k: %.2f ms/frame", remove_ms / FRAMES);
+    test_report("toggle:           %.2f ms/frame", (add_ms + remove_ms) / FRAMES);
+
+    for (EntityID entity : entities)
+    {
+        entity_destroy(entity);
+    }
+
+    entity_flush_events();
+}
@@ -0,0 +1,151 @@
+#include "test.h"
+
+using namespace nit;
+
+struct Tag
+{
+    u32 value = 0;
+};
+
+struct OtherTag
+{
+    u32 value = 0;
+};
+
+static constexpr u32 LISTENER_COUNT = 10;
+static u32 listener_calls = 0;
+
+// Ten distinct functions, the events look listeners up by address
+template<u32 N>
+static ListenerAction filtering_listener(const ComponentAddedArgs& args)
+{
+    // What the systems did before the per type observers, every listener sees every add
+    if (args.type == type_get<OtherTag>())
+    {
+        ++listener_calls;
+    }
+
+    return ListenerAction::StayListening;
+}
+
+template<u32 N>
+static ListenerAction counting_listener(const ComponentAddedArgs&)
+{
+    ++listener_calls;
+    return ListenerAction::StayListening;
+}
+
+template<u32... N>
+static void bind_listeners(ComponentAddedEvent& event, bool filtering, bool add, std::integer_sequence<u32, N...>)
+{
+    if (add)
+    {
+        ((event += ComponentAddedListener::create(filtering ? filtering_listener<N> : counting_listener<N>)), ...);
+    }
+    else
+    {
+        ((event -= ComponentAddedListener::create(filtering ? filtering_listener<N> : counting_listener<N>)), ...);
+    }
+}
+
+static void bind_listeners(ComponentAddedEvent& event, bool filtering, bool add)
+{
+    bind_listeners(event, filtering, add, std::make_integer_sequence<u32, LISTENER_COUNT>());
+}
+
+NIT_TEST(event_listeners_removed_while_broadcasting)
+{
+    test_component_register<Tag>();
+    ComponentAddedEvent& event = entity_on_add<Tag>();
+    bind_listeners(event, false, true);
+    listener_calls = 0;
+
+    // The first listener removes all of them, the ones left in the broadcast are skipped
+    static ComponentAddedEvent* removing_event = nullptr;
+    removing_event = &event;
+    ComponentAddedListener remove_all = ComponentAddedListener::create([](const ComponentAddedArgs&)
+    {
+        bind_listeners(*removing_event, false, false);
+        return ListenerAction::StopListening;
+    });
+
+    event.listeners.insert(event.listeners.begin(), remove_all);
+
+    EntityID entity = entity_create();
+    entity_add<Tag>(entity);
+    TEST_CHECK(listener_calls == 0);
+    TEST_CHECK(event.listeners.empty());
+    TEST_CHECK(!event.broadcasting);
+
+    entity_destroy(entity);
+    entity_flush_events();
+}
+
+// Adds the Tag component count times over the entities, removing it between rounds. Returns the ms spent adding.
+static f64 add_tags(const Array<EntityID>& entities, u32 count)
+{
+    f64 add_ms = 0.0;
+
+    for (u32 added = 0; added < count; added += (u32) entities.size())
+    {
+        const f64 start = test_now_ms();
+
+        for (EntityID entity : entities)
+        {
+            entity_add<Tag>(entity);
+        }
+
+        add_ms += test_now_ms() - start;
+
+        for (EntityID entity : entities)
+        {
+            entity_remove<Tag>(entity);
+        }
+    }
+
+    return add_ms;
+}
+
+NIT_BENCHMARK(event_broadcast_1m_adds_10_listeners)
+{
+    constexpr u32 ADD_COUNT    = 1000000;
+    constexpr u32 ENTITY_COUNT = 100000;
+
+    test_component_register<Tag>();
+    test_component_register<OtherTag>();
+
+    Array<EntityID> entities;
+
+    for (u32 i = 0; i < ENTITY_COUNT; ++i)
+    {
+        entities.push_back(entity_create());
+    }
+
+    ComponentAddedEvent& global_event = entity_registry_get_instance()->component_added_event;
+    const f64 no_listeners = add_tags(entities, ADD_COUNT);
+
+    bind_listeners(global_event, true, true);
+    const f64 global_filtering = add_tags(entities, ADD_COUNT);
+    bind_listeners(global_event, true, false);
+
+    bind_listeners(entity_on_add<OtherTag>(), false, true);
+    const f64 other_type = add_tags(entities, ADD_COUNT);
+    bind_listeners(entity_on_add<OtherTag>(), false, false);
+
+    listener_calls = 0;
+    bind_listeners(entity_on_add<Tag>(), false, true);
+    const f64 same_type = add_tags(entities, ADD_COUNT);
+    bind_listeners(entity_on_add<Tag>(), false, false);
+
+    test_report("no listeners:                     %.1f ms", no_listeners);
+    test_report("10 global filtering listeners:    %.1f ms", global_filtering);
+    test_report("10 observers of another type:     %.1f ms", other_type);
+    test_report("10 observers of the added type:   %.1f ms (%u calls)", same_type, listener_calls);
+
+    for (EntityID entity : entities)
+    {
+        entity_destroy(entity);
+    }
+
+    entity_flush_events();
+}
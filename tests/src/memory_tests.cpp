@@ -0,0 +1,45 @@
+#include "test.h"
+
+using namespace nit;
+
+#ifdef NIT_ALLOCATION_COUNTER
+struct alignas(64) CacheLine
+{
+    u8 bytes[64];
+};
+
+// The pointers escape through it, otherwise the compiler can drop a new / delete pair
+static void* volatile escaped = nullptr;
+
+template<typename T>
+static void new_and_delete()
+{
+    T* single = new T;
+    escaped = single;
+    delete single;
+
+    T* array = new T[4];
+    escaped = array;
+    delete[] array;
+
+    T* single_nothrow = new (std::nothrow) T;
+    escaped = single_nothrow;
+    delete single_nothrow;
+
+    T* array_nothrow = new (std::nothrow) T[4];
+    escaped = array_nothrow;
+    delete[] array_nothrow;
+}
+
+NIT_TEST(memory_counter_sees_every_operator_new)
+{
+    const u64 before = memory_heap_allocations();
+    new_and_delete<u32>();
+    new_and_delete<CacheLine>();
+    TEST_CHECK(memory_heap_allocations() - before == 8);
+
+    CacheLine* line = new CacheLine;
+    TEST_CHECK(reinterpret_cast<uintptr_t>(line) % alignof(CacheLine) == 0);
+    delete line;
+}
+#endif
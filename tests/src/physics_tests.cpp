@@ -0,0 +1,87 @@
+#include "test.h"
+
+using namespace nit;
+
+// What engine_init sets up for the physics, without the window and the renderer
+static void physics_setup()
+{
+    if (component_type_index<Rigidbody2D> == 0)
+    {
+        register_rigidbody_2d_component();
+        register_box_collider_2d_component();
+        register_circle_collider_component();
+        register_trigger_events_component();
+        register_collision_category_component();
+    }
+
+    if (!physics_2d_has_instance())
+    {
+        asset_registry_set_instance(&engine_get_instance()->asset_registry);
+        physics_2d_set_instance(&engine_get_instance()->physics_2d);
+        physics_2d_init();
+    }
+}
+
+static EntityID spawn_box(const Vector2& position, const Vector2& size, BodyType body_type)
+{
+    EntityID entity = entity_create();
+    entity_add<Transform>(entity).position = to_v3(position);
+    entity_add<Rigidbody2D>(entity, { .body_type = body_type, .gravity_scale = 1.f });
+    entity_add<BoxCollider2D>(entity, { .size = size });
+    return entity;
+}
+
+// A pile of body_count boxes falling on the floor, returns the ms per step
+static f64 step_falling_boxes(u32 thread_count, u32 body_count, u32 steps)
+{
+    constexpr u32 COLUMNS = 100;
+
+    test_set_threads(thread_count);
+
+    // The world takes the worker count when it gets created
+    physics_2d_finish();
+
+    Array<EntityID> entities;
+    entities.push_back(spawn_box({ 0.f, -1.f }, { COLUMNS * 1.2f, 1.f }, BodyType::Static));
+
+    for (u32 i = 0; i < body_count; ++i)
+    {
+        const Vector2 position = { ((f32) (i % COLUMNS) - COLUMNS / 2.f) * 0.6f, 1.f + (f32) (i / COLUMNS) * 0.6f };
+        entities.push_back(spawn_box(position, { 0.5f, 0.5f }, BodyType::Dynamic));
+    }
+
+    // The first step creates the bodies and the shapes
+    physics_2d_step();
+    const f64 start = test_now_ms();
+
+    for (u32 step = 0; step < steps; ++step)
+    {
+        physics_2d_step();
+    }
+
+    const f64 step_ms = (test_now_ms() - start) / steps;
+
+    for (EntityID entity : entities)
+    {
+        entity_destroy(entity);
+    }
+
+    entity_flush_events();
+    physics_2d_finish();
+    return step_ms;
+}
+
+NIT_BENCHMARK(physics_5k_dynamic_bodies)
+{
+    constexpr u32 BODY_COUNT = 5000;
+    constexpr u32 STEPS      = 60;
+
+    physics_setup();
+    const u32 hardware_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    for (u32 thread_count : { 1u, 4u, hardware_threads })
+    {
+        const f64 step_ms = step_falling_boxes(thread_count, BODY_COUNT, STEPS);
+        test_report("%2u threads, %u physics workers: %.2f ms per step", thread_count, physics_2d_worker_count(), step_ms);
+    }
+}
@@ -0,0 +1,90 @@
+#include "test.h"
+
+using namespace nit;
+
+// Stands in for a component with a handle to an object owned by a system, like Rigidbody2D and its body
+struct Body
+{
+    u32 handle = 0;
+    f32 mass   = 1.f;
+};
+
+static void on_body_prefab_copy(void* data)
+{
+    static_cast<Body*>(data)->handle = 0;
+}
+
+static void body_register()
+{
+    if (component_type_index<Body> == 0)
+    {
+        component_register<Body>();
+        delegate_bind(entity_find_component_pool<Body>()->fn_on_prefab_copy, on_body_prefab_copy);
+    }
+}
+
+NIT_TEST(prefab_copy_drops_system_handles)
+{
+    body_register();
+
+    EntityID source = entity_create();
+    entity_add<Body>(source, { .handle = 7, .mass = 3.f });
+
+    Prefab prefab;
+    prefab_load(&prefab, source);
+    TEST_CHECK(prefab_get<Body>(&prefab)->handle == 0);
+    TEST_CHECK(prefab_get<Body>(&prefab)->mass == 3.f);
+
+    // The source keeps its own
+    TEST_CHECK(entity_get_const<Body>(source).handle == 7);
+
+    EntityID instance = prefab_instantiate(&prefab, V3_ZERO);
+    TEST_CHECK(entity_get_const<Body>(instance).handle == 0);
+    TEST_CHECK(entity_get_const<Body>(instance).mass == 3.f);
+
+    prefab_free(&prefab);
+    entity_destroy(instance);
+    entity_destroy(source);
+    entity_flush_events();
+}
+
+static void on_body_recycle(void* component, const void* prefab_data)
+{
+    Body* body = static_cast<Body*>(component);
+    const u32 handle = body->handle;
+    *body = *static_cast<const Body*>(prefab_data);
+    body->handle = handle;
+}
+
+NIT_TEST(entity_recycler_keeps_system_handles)
+{
+    body_register();
+    delegate_bind(entity_find_component_pool<Body>()->fn_on_recycle, on_body_recycle);
+
+    EntityID source = entity_create();
+    entity_add<Body>(source, { .mass = 2.f });
+
+    Prefab prefab;
+    prefab_load(&prefab, source);
+
+    EntityRecycler recycler;
+    entity_recycler_load(&recycler, &prefab, 1);
+
+    EntityID instance = entity_recycler_acquire(&recycler);
+    Body& body = entity_get<Body>(instance);
+    body.handle = 42;
+    body.mass   = 9.f;
+    entity_recycler_release(&recycler, instance);
+
+    // The same entity comes back with the prefab data and the handle it was given
+    TEST_CHECK(entity_recycler_acquire(&recycler) == instance);
+    TEST_CHECK(entity_get_const<Body>(instance).handle == 42);
+    TEST_CHECK(entity_get_const<Body>(instance).mass == 2.f);
+
+    delegate_unbind(entity_find_component_pool<Body>()->fn_on_recycle);
+    entity_destroy(instance);
+    entity_recycler_free(&recycler);
+    prefab_free(&prefab);
+    entity_destroy(source);
+    entity_flush_events();
+}
@@ -0,0 +1,142 @@
+#include "test.h"
+#include <cstdarg>
+
+using namespace nit;
+
+static Array<TestCase>& test_cases()
+{
+    static Array<TestCase> cases;
+    return cases;
+}
+
+static bool current_failed = false;
+
+namespace nit
+{
+    bool test_register(const char* name, TestFunc func, bool benchmark)
+    {
+        test_cases().push_back({ name, func, benchmark });
+        return true;
+    }
+
+    void test_fail(const char* condition, const char* file, u32 line)
+    {
+        current_failed = true;
+        NIT_PRINTLN("    %s:%u: check failed: %s", file, line, condition);
+    }
+
+    void test_report(const char* format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        NIT_PRINT("    ");
+        vprintf(format, args);
+        NIT_PRINT("\n");
+        va_end(args);
+    }
+
+    f64 test_now_ms()
+    {
+        using Clock = std::chrono::steady_clock;
+        return std::chrono::duration<f64, std::milli>(Clock::now().time_since_epoch()).count();
+    }
+
+    void test_set_threads(u32 thread_count)
+    {
+        NIT_CHECK(thread_count > 0);
+        JobSystem* job_system = job_system_get_instance();
+
+        if (job_thread_count() == thread_count)
+        {
+            return;
+        }
+
+        job_system_finish();
+        job_system->worker_count = thread_count - 1;
+        job_system_init();
+    }
+
+    void test_set_registry(EntityStorage storage, u32 max_entities)
+    {
+        EntityRegistry* entity_registry = entity_registry_get_instance();
+
+        if (entity_registry->storage == storage && entity_registry->max_entities == max_entities)
+        {
+            return;
+        }
+
+        entity_registry_finish();
+        entity_registry->storage      = storage;
+        entity_registry->max_entities = max_entities;
+        entity_registry_init();
+        register_transform_component();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool          run_benchmarks = false;
+    Array<String> names;
+
+    for (i32 i = 1; i < argc; ++i)
+    {
+        if (String(argv[i]) == "--bench")
+        {
+            run_benchmarks = true;
+            continue;
+        }
+
+        names.push_back(argv[i]);
+    }
+
+    // Only the registries the cases need, there is no window or render context
+    static Engine engine;
+    engine_set_instance(&engine);
+    engine.delta_seconds = 1.f / 60.f;
+
+    type_registry_set_instance(&engine.type_registry);
+    type_registry_init();
+
+    job_system_set_instance(&engine.job_system);
+    job_system_init();
+    const u32 default_threads = job_thread_count();
+
+    constexpr u32 DEFAULT_MAX_ENTITIES = 200000;
+    engine.entity_registry.max_entities = DEFAULT_MAX_ENTITIES;
+    entity_registry_set_instance(&engine.entity_registry);
+    entity_registry_init();
+    register_transform_component();
+
+    u32 run_count    = 0;
+    u32 failed_count = 0;
+
+    for (const TestCase& test_case : test_cases())
+    {
+        const bool selected = names.empty()
+            ? !test_case.benchmark || run_benchmarks
+            : std::find(names.begin(), names.end(), test_case.name) != names.end();
+
+        if (!selected)
+        {
+            continue;
+        }
+
+        NIT_PRINTLN("[ RUN  ] %s", test_case.name);
+        current_failed = false;
+        const f64 start = test_now_ms();
+        test_case.func();
+        const f64 elapsed = test_now_ms() - start;
+        test_set_threads(default_threads);
+        test_set_registry(EntityStorage::Pool, DEFAULT_MAX_ENTITIES);
+
+        NIT_PRINTLN("[%s] %s (%.1f ms)", current_failed ? " FAIL " : "  OK  ", test_case.name, elapsed);
+        failed_count += current_failed ? 1 : 0;
+        ++run_count;
+    }
+
+    NIT_PRINTLN("%u of %u passed", run_count - failed_count, run_count);
+
+    entity_registry_finish();
+    job_system_finish();
+    return failed_count == 0 ? 0 : 1;
+}
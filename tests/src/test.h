@@ -0,0 +1,58 @@
+#pragma once
+#include "nit.h"
+
+// Tests and benchmarks register themselves at static initialization:
+//
+//     NIT_TEST(transform_matches_parent_walk) { ... TEST_CHECK(a == b); ... }
+//     NIT_BENCHMARK(transform_hierarchy_10k)  { ... test_report("%.3f ms", ms); }
+//
+// Running the executable without arguments runs every test, --bench runs the benchmarks too and any other
+// argument selects the cases with that name. Every case runs against the same engine registries, so it should
+// destroy the entities it creates before returning.
+#define NIT_TEST_CONCAT_INNER(_A, _B) _A##_B
+#define NIT_TEST_CONCAT(_A, _B) NIT_TEST_CONCAT_INNER(_A, _B)
+
+#define NIT_TEST_CASE(_NAME, _BENCHMARK) \
+static void _NAME(); \
+static const bool NIT_TEST_CONCAT(_NAME, _registered) = nit::test_register(#_NAME, _NAME, _BENCHMARK); \
+static void _NAME()
+
+#define NIT_TEST(_NAME) NIT_TEST_CASE(_NAME, false)
+#define NIT_BENCHMARK(_NAME) NIT_TEST_CASE(_NAME, true)
+
+#define TEST_CHECK(_CONDITION) \
+if (!(_CONDITION)) { nit::test_fail(#_CONDITION, __FILE__, __LINE__); return; }
+
+namespace nit
+{
+    using TestFunc = void(*)();
+
+    struct TestCase
+    {
+        const char* name      = nullptr;
+        TestFunc    func      = nullptr;
+        bool        benchmark = false;
+    };
+
+    bool test_register(const char* name, TestFunc func, bool benchmark);
+    void test_fail(const char* condition, const char* file, u32 line);
+    void test_report(const char* format, ...);
+    f64  test_now_ms();
+
+    // The cases share one registry, so each component type is registered by the first case that uses it
+    template<typename T>
+    void test_component_register()
+    {
+        if (component_type_index<T> == 0)
+        {
+            component_register<T>();
+        }
+    }
+
+    // Runs the job system with thread_count threads, the calling one included, until test_set_threads is called again
+    void test_set_threads(u32 thread_count);
+
+    // Finishes the entity registry and initializes it again with the given storage and capacity, until the case
+    // returns. Every component type, Transform aside, has to be registered again after it.
+    void test_set_registry(EntityStorage storage, u32 max_entities);
+}
@@ -0,0 +1,2 @@
+#pragma once
+#include "nit_pch.h"
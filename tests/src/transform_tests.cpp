@@ -0,0 +1,160 @@
+#include "test.h"
+
+using namespace nit;
+
+// transform_to_matrix before the world transforms were cached, every entity walked its parents up to the root
+static Matrix4 parent_walk_matrix(const Transform& transform, EntityID entity)
+{
+    EntityID parent = entity_get_parent(entity);
+
+    if (!entity_valid(parent) || !entity_has<Transform>(parent))
+    {
+        return mat_create_transform(transform.position, transform.rotation, transform.scale);
+    }
+
+    Vector3 child_pos = transform.position;
+    Vector3 child_rot = transform.rotation;
+    Vector3 child_scl = transform.scale;
+
+    while (entity_valid(entity_get_parent(entity)))
+    {
+        parent = entity_get_parent(entity);
+
+        const Transform& parent_transform = entity_get_const<Transform>(parent);
+        const Vector3& parent_pos = parent_transform.position;
+        const Vector3& parent_rot = parent_transform.rotation;
+
+        child_pos = child_pos + parent_pos;
+        child_pos = to_v3(rotate_around(to_v2(parent_pos), parent_rot.z, to_v2(child_pos)));
+
+        child_rot = child_rot + parent_rot;
+        child_scl = multiply(child_scl, parent_transform.scale);
+        entity = parent;
+    }
+
+    return mat_create_transform(child_pos, child_rot, child_scl);
+}
+
+// chain_count chains of depth entities, every entity is the parent of the next one
+static void create_chains(Array<EntityID>& entities, u32 chain_count, u32 depth)
+{
+    for (u32 chain = 0; chain < chain_count; ++chain)
+    {
+        for (u32 level = 0; level < depth; ++level)
+        {
+            const u32 i = chain * depth + level;
+            EntityID entity = entity_create();
+            Transform& transform = entity_add<Transform>(entity);
+            transform.position = { (f32) level * 1.5f, (f32) (i % 7) - 3.f, 0.f };
+            transform.rotation = { 0.f, 0.f, (f32) (i * 13 % 360) };
+            transform.scale    = { 1.f + (f32) (i % 3) * 0.25f, 1.f, 1.f };
+
+            if (level > 0)
+            {
+                entity_set_parent(entity, entities.back());
+            }
+
+            entities.push_back(entity);
+        }
+    }
+
+    entity_flush_events();
+}
+
+static void destroy_chains(Array<EntityID>& entities)
+{
+    // Destroying a parent destroys its children, after a reparent they can come before it
+    for (auto it = entities.rbegin(); it != entities.rend(); ++it)
+    {
+        if (entity_valid(*it))
+        {
+            entity_destroy(*it);
+        }
+    }
+
+    entity_flush_events();
+    entities.clear();
+}
+
+static f32 max_difference(const Array<EntityID>& entities)
+{
+    f32 difference = 0.f;
+
+    for (EntityID entity : entities)
+    {
+        const Matrix4 expected = parent_walk_matrix(entity_get_const<Transform>(entity), entity);
+        const Matrix4 cached   = transform_get_global(entity).matrix;
+        const Matrix4 computed = transform_to_matrix(entity_get_const<Transform>(entity), entity);
+
+        for (u32 i = 0; i < 16; ++i)
+        {
+            difference = std::max(difference, std::abs(expected.n[i] - cached.n[i]));
+            difference = std::max(difference, std::abs(expected.n[i] - computed.n[i]));
+        }
+    }
+
+    return difference;
+}
+
+NIT_TEST(transform_world_matches_parent_walk)
+{
+    constexpr f32 TOLERANCE = 1e-3f;
+
+    Array<EntityID> entities;
+    create_chains(entities, 100, 8);
+
+    transform_update_global_transforms();
+    TEST_CHECK(max_difference(entities) < TOLERANCE);
+
+    // A root change has to reach the whole chain
+    entity_get<Transform>(entities[0]).rotation.z = 45.f;
+    entity_get<Transform>(entities[8]).position.x += 10.f;
+    transform_update_global_transforms();
+    TEST_CHECK(max_difference(entities) < TOLERANCE);
+
+    // So does moving a subtree under another parent
+    entity_set_parent(entities[5], entities[10]);
+    transform_update_global_transforms();
+    TEST_CHECK(max_difference(entities) < TOLERANCE);
+
+    destroy_chains(entities);
+}
+
+NIT_BENCHMARK(transform_hierarchy_10k_depth_8)
+{
+    constexpr u32 DEPTH       = 8;
+    constexpr u32 CHAIN_COUNT = 10000 / DEPTH;
+    constexpr u32 FRAME_COUNT = 100;
+
+    Array<EntityID> entities;
+    create_chains(entities, CHAIN_COUNT, DEPTH);
+
+    // Every root moves each frame, so every world transform has to be rebuilt
+    f64 start = test_now_ms();
+
+    for (u32 frame = 0; frame < FRAME_COUNT; ++frame)
+    {
+        for (u32 chain = 0; chain < CHAIN_COUNT; ++chain)
+        {
+            entity_get<Transform>(entities[chain * DEPTH]).rotation.z += 1.f;
+        }
+
+        transform_update_global_transforms();
+    }
+
+    test_report("cached world transforms: %.3f ms per frame", (test_now_ms() - start) / FRAME_COUNT);
+
+    start = test_now_ms();
+    f32 sink = 0.f;
+
+    for (u32 frame = 0; frame < FRAME_COUNT; ++frame)
+    {
+        for (EntityID entity : entities)
+        {
+            sink += parent_walk_matrix(entity_get_const<Transform>(entity), entity).m[3][0];
+        }
+    }
+
+    test_report("parent walk per entity:  %.3f ms per frame (%g)", (test_now_ms() - start) / FRAME_COUNT, sink);
+    destroy_chains(entities);
+}
@@ -0,0 +1,123 @@
+#include "test.h"
+
+using namespace nit;
+
+// Stands in for the GPU, fences are numbered in creation order and signal as soon as they are waited on
+struct FakeDevice
+{
+    u64        next_fence = 1;
+    Array<u64> waited;
+    Array<u64> destroyed;
+    Array<u64> upload_offsets;
+    Array<u64> upload_sizes;
+};
+
+static FakeDevice fake_device;
+
+static VertexRingDevice create_fake_device()
+{
+    fake_device = {};
+
+    VertexRingDevice device;
+    device.fn_create_fence  = []() -> void* { return reinterpret_cast<void*>(fake_device.next_fence++); };
+    device.fn_wait_fence    = [](void* fence) { if (fence) fake_device.waited.push_back(reinterpret_cast<u64>(fence)); };
+    device.fn_destroy_fence = [](void* fence) { if (fence) fake_device.destroyed.push_back(reinterpret_cast<u64>(fence)); };
+    device.fn_upload        = [](u32, const void*, u64 size, u64 offset)
+    {
+        fake_device.upload_offsets.push_back(offset);
+        fake_device.upload_sizes.push_back(size);
+    };
+    return device;
+}
+
+NIT_TEST(vertex_ring_commits_inside_the_region)
+{
+    constexpr u64 REGION_SIZE = 256;
+    u8 memory[REGION_SIZE * VERTEX_RING_REGIONS];
+
+    VertexRing ring;
+    vertex_ring_init(&ring, REGION_SIZE, memory, false, create_fake_device());
+
+    TEST_CHECK(vertex_ring_head(&ring) == memory);
+    TEST_CHECK(vertex_ring_fits(&ring, REGION_SIZE));
+    TEST_CHECK(!vertex_ring_fits(&ring, REGION_SIZE + 1));
+
+    vertex_ring_commit(&ring, 100);
+    vertex_ring_commit(&ring, 60);
+    TEST_CHECK(vertex_ring_head(&ring) == memory + 160);
+    TEST_CHECK(vertex_ring_fits(&ring, 96));
+    TEST_CHECK(!vertex_ring_fits(&ring, 97));
+
+    vertex_ring_next_region(&ring);
+    TEST_CHECK(ring.region == 1);
+    TEST_CHECK(vertex_ring_head(&ring) == memory + REGION_SIZE);
+    TEST_CHECK(vertex_ring_fits(&ring, REGION_SIZE));
+
+    // Mapped memory is written in place, nothing gets uploaded
+    TEST_CHECK(fake_device.upload_sizes.empty());
+
+    vertex_ring_free(&ring);
+    TEST_CHECK(ring.mapped == nullptr);
+}
+
+NIT_TEST(vertex_ring_waits_for_the_region_it_enters)
+{
+    constexpr u64 REGION_SIZE = 64;
+    u8 memory[REGION_SIZE * VERTEX_RING_REGIONS];
+
+    VertexRing ring;
+    vertex_ring_init(&ring, REGION_SIZE, memory, false, create_fake_device());
+
+    // First lap, every region left gets a fence and the regions entered were never used
+    for (u32 i = 0; i < VERTEX_RING_REGIONS - 1; ++i)
+    {
+        vertex_ring_commit(&ring, REGION_SIZE);
+        vertex_ring_next_region(&ring);
+    }
+
+    TEST_CHECK(fake_device.next_fence == VERTEX_RING_REGIONS);
+    TEST_CHECK(fake_device.waited.empty());
+
+    // Coming back to region 0 waits for the fence placed when it was left, which is then released
+    vertex_ring_commit(&ring, REGION_SIZE);
+    vertex_ring_next_region(&ring);
+    TEST_CHECK(ring.region == 0);
+    TEST_CHECK(ring.head == 0);
+    TEST_CHECK(fake_device.waited.size() == 1 && fake_device.waited[0] == 1);
+    TEST_CHECK(fake_device.destroyed.size() == 1 && fake_device.destroyed[0] == 1);
+    TEST_CHECK(ring.fences[0] == nullptr);
+
+    // Second lap enters region 1, fenced by the second fence
+    vertex_ring_next_region(&ring);
+    TEST_CHECK(ring.region == 1);
+    TEST_CHECK(fake_device.waited.size() == 2 && fake_device.waited[1] == 2);
+
+    // Free releases the fences still pending, the one on region 0 and the one on region 2
+    vertex_ring_free(&ring);
+    TEST_CHECK(fake_device.destroyed.size() == 4);
+}
+
+NIT_TEST(vertex_ring_staging_uploads_each_commit)
+{
+    constexpr u64 REGION_SIZE = 128;
+    u8 memory[REGION_SIZE * VERTEX_RING_REGIONS];
+
+    VertexRing ring;
+    vertex_ring_init(&ring, REGION_SIZE, memory, true, create_fake_device());
+
+    vertex_ring_commit(&ring, 32);
+    vertex_ring_commit(&ring, 48);
+    vertex_ring_next_region(&ring);
+    vertex_ring_commit(&ring, 16);
+
+    // Each commit uploads its own bytes at the offset of the buffer they were written to
+    TEST_CHECK(fake_device.upload_offsets.size() == 3);
+    TEST_CHECK(fake_device.upload_offsets[0] == 0   && fake_device.upload_sizes[0] == 32);
+    TEST_CHECK(fake_device.upload_offsets[1] == 32  && fake_device.upload_sizes[1] == 48);
+    TEST_CHECK(fake_device.upload_offsets[2] == 128 && fake_device.upload_sizes[2] == 16);
+
+    // glBufferSubData already synchronizes, staging rings never create fences
+    TEST_CHECK(fake_device.next_fence == 1);
+
+    vertex_ring_free(&ring);
+}